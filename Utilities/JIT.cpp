@@ -8,6 +8,7 @@
 #include "VirtualMemory.h"
 #include <immintrin.h>
 #include <zlib.h>
+#include <unordered_map>
 
 #ifdef __linux__
 #include <sys/mman.h>
@@ -107,6 +108,63 @@ static u8* add_jit_memory(std::size_t size, uint align)
 	return pointer + pos;
 }
 
+// Reclaimable part of the code heap, small blocks of power-of-two size classes allocated from the code subrange
+struct jit_code_heap
+{
+	static constexpr u32 min_block_size = 64;
+	static constexpr u32 class_count = 15; // Up to 1 MiB
+
+	shared_mutex mutex;
+
+	// Reusable blocks per size class
+	std::array<std::vector<u8*>, class_count> free_list;
+
+	// Blocks in use or retired (pointer -> size class)
+	std::unordered_map<const void*, u8> blocks;
+
+	// Retired blocks with the epoch of retirement
+	std::vector<std::pair<u8*, u64>> retired;
+
+	u64 epoch = 0;
+
+	// Statistics
+	u64 stat_allocated = 0;
+	u64 stat_reused = 0;
+	u64 stat_reclaimed = 0;
+	u64 retired_size = 0;
+
+	static u32 get_class(std::size_t size)
+	{
+		u32 index = 0;
+
+		while ((min_block_size << index) < size)
+		{
+			index++;
+		}
+
+		return index;
+	}
+
+	void reset()
+	{
+		for (auto& list : free_list)
+		{
+			list.clear();
+		}
+
+		blocks.clear();
+		retired.clear();
+		retired_size = 0;
+	}
+};
+
+static jit_code_heap& get_code_heap()
+{
+	// Magic static
+	static jit_code_heap s_heap;
+	return s_heap;
+}
+
 jit_runtime::jit_runtime()
 	: HostRuntime()
 {
@@ -162,6 +220,115 @@ u8* jit_runtime::alloc(std::size_t size, uint align, bool exec) noexcept
 	}
 }
 
+u8* jit_runtime::alloc_reclaimable(std::size_t size) noexcept
+{
+	auto& heap = get_code_heap();
+
+	const u32 index = jit_code_heap::get_class(size);
+
+	if (index >= jit_code_heap::class_count)
+	{
+		// Too big, never reclaimed
+		return alloc(size, 16, true);
+	}
+
+	std::lock_guard lock(heap.mutex);
+
+	u8* ptr = nullptr;
+
+	if (auto& list = heap.free_list[index]; !list.empty())
+	{
+		ptr = list.back();
+		list.pop_back();
+		heap.stat_reused++;
+	}
+	else
+	{
+		// Blocks of the same class are allocated from the code subrange next to each other
+		ptr = alloc(jit_code_heap::min_block_size << index, 16, true);
+
+		if (!ptr)
+		{
+			return nullptr;
+		}
+
+		heap.stat_allocated++;
+	}
+
+	heap.blocks[ptr] = static_cast<u8>(index);
+	return ptr;
+}
+
+bool jit_runtime::retire(const void* ptr) noexcept
+{
+	auto& heap = get_code_heap();
+
+	std::lock_guard lock(heap.mutex);
+
+	const auto found = heap.blocks.find(ptr);
+
+	if (found == heap.blocks.end())
+	{
+		return false;
+	}
+
+	heap.retired.emplace_back(static_cast<u8*>(const_cast<void*>(ptr)), heap.epoch);
+	heap.retired_size += jit_code_heap::min_block_size << found->second;
+	return true;
+}
+
+u64 jit_runtime::next_epoch() noexcept
+{
+	auto& heap = get_code_heap();
+
+	std::lock_guard lock(heap.mutex);
+
+	return ++heap.epoch;
+}
+
+void jit_runtime::reclaim(u64 epoch) noexcept
+{
+	auto& heap = get_code_heap();
+
+	std::lock_guard lock(heap.mutex);
+
+	u64 count = 0;
+	u64 size = 0;
+
+	for (auto it = heap.retired.begin(); it != heap.retired.end();)
+	{
+		if (it->second >= epoch)
+		{
+			it++;
+			continue;
+		}
+
+		const auto found = heap.blocks.find(it->first);
+		const u32 index = found->second;
+		heap.blocks.erase(found);
+
+		heap.free_list[index].push_back(it->first);
+		size += jit_code_heap::min_block_size << index;
+		count++;
+
+		it = heap.retired.erase(it);
+	}
+
+	heap.retired_size -= size;
+	heap.stat_reclaimed += count;
+
+	jit_log.notice("JIT: Reclaimed %u blocks (%u KiB), %u blocks in use", count, size / 1024, heap.blocks.size() - heap.retired.size());
+}
+
+u64 jit_runtime::get_retired_size() noexcept
+{
+	auto& heap = get_code_heap();
+
+	reader_lock lock(heap.mutex);
+
+	return heap.retired_size;
+}
+
 void jit_runtime::initialize()
 {
 	if (!s_code_init.empty() || !s_data_init.empty())
@@ -178,6 +345,23 @@ void jit_runtime::initialize()
 
 void jit_runtime::finalize() noexcept
 {
+	{
+		auto& heap = get_code_heap();
+
+		std::lock_guard lock(heap.mutex);
+
+		if (heap.stat_allocated)
+		{
+			jit_log.notice("JIT: Code heap: %u MiB code, %u MiB data, %u blocks allocated, %u reused, %u reclaimed",
+				(s_code_pos & 0xffff'ffff) >> 20, (s_data_pos & 0xffff'ffff) >> 20, heap.stat_allocated, heap.stat_reused, heap.stat_reclaimed);
+		}
+
+		heap.reset();
+		heap.stat_allocated = 0;
+		heap.stat_reused = 0;
+		heap.stat_reclaimed = 0;
+	}
+
 	// Reset JIT memory
 #ifdef CAN_OVERCOMMIT
 	utils::memory_reset(get_jit_memory(), 0x80000000);
@@ -907,9 +1091,13 @@ class ObjectCache final : public llvm::ObjectCache
 {
 	const std::string& m_path;
 
+	// Store objects with gzip compression (uncompressed objects can be mapped directly)
+	const bool m_compress;
+
 public:
-	ObjectCache(const std::string& path)
+	ObjectCache(const std::string& path, bool compress = true)
 		: m_path(path)
+		, m_compress(compress)
 	{
 	}
 
@@ -919,7 +1107,14 @@ public:
 	{
 		std::string name = m_path;
 		name.append(_module->getName().data());
-		//fs::file(name, fs::rewrite).write(obj.getBufferStart(), obj.getBufferSize());
+
+		if (!m_compress)
+		{
+			fs::file(name, fs::rewrite).write(obj.getBufferStart(), obj.getBufferSize());
+			jit_log.notice("LLVM: Created module: %s", _module->getName().data());
+			return;
+		}
+
 		name.append(".gz");
 
 		z_stream zs{};
@@ -963,13 +1158,24 @@ public:
 		if (fs::file cached{path + ".gz", fs::read})
 		{
 			std::vector<uchar> gz = cached.to_vector<uchar>();
-			std::vector<uchar> out;
 			z_stream zs{};
 
-			if (gz.empty()) [[unlikely]]
+			// Header, footer and at least one byte of data
+			if (gz.size() <= 18) [[unlikely]]
 			{
 				return nullptr;
 			}
+
+			// The gzip footer contains the uncompressed size (little-endian), inflate directly into the final buffer
+			u32 out_size;
+			std::memcpy(&out_size, gz.data() + gz.size() - 4, sizeof(out_size));
+
+			if (out_size == 0) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			auto buf = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(out_size);
 #ifndef _MSC_VER
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -978,56 +1184,29 @@ public:
 #ifndef _MSC_VER
 #pragma GCC diagnostic pop
 #endif
-			zs.avail_in = static_cast<uInt>(gz.size());
-			zs.next_in  = gz.data();
-			out.resize(gz.size() * 6);
-			zs.avail_out = static_cast<uInt>(out.size());
-			zs.next_out  = out.data();
+			zs.avail_in  = static_cast<uInt>(gz.size());
+			zs.next_in   = gz.data();
+			zs.avail_out = static_cast<uInt>(out_size);
+			zs.next_out  = reinterpret_cast<uchar*>(buf->getBufferStart());
 
-			while (zs.avail_in)
-			{
-				switch (inflate(&zs, Z_FINISH))
-				{
-				case Z_OK: break;
-				case Z_STREAM_END: break;
-				case Z_BUF_ERROR:
-				{
-					if (zs.avail_in)
-						break;
-					[[fallthrough]];
-				}
-				default:
-					inflateEnd(&zs);
-					return nullptr;
-				}
+			const int res = inflate(&zs, Z_FINISH);
+			inflateEnd(&zs);
 
-				if (zs.avail_in)
-				{
-					auto cur_size = zs.next_out - out.data();
-					out.resize(out.size() + 65536);
-					zs.avail_out = static_cast<uInt>(out.size() - cur_size);
-					zs.next_out = out.data() + cur_size;
-				}
+			if (res != Z_STREAM_END || zs.avail_out) [[unlikely]]
+			{
+				return nullptr;
 			}
 
-			out.resize(zs.next_out - out.data());
-			inflateEnd(&zs);
-
-			auto buf = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(out.size());
-			std::memcpy(buf->getBufferStart(), out.data(), out.size());
 			return buf;
 		}
 
-		if (fs::file cached{path, fs::read})
+		if (fs::is_file(path))
 		{
-			if (cached.size() == 0) [[unlikely]]
+			// Map uncompressed objects instead of reading them
+			if (auto buf = llvm::MemoryBuffer::getFile(path, -1, false); buf && (*buf)->getBufferSize())
 			{
-				return nullptr;
+				return std::move(*buf);
 			}
-
-			auto buf = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(cached.size());
-			cached.read(buf->getBufferStart(), buf->getBufferSize());
-			return buf;
 		}
 
 		return nullptr;
@@ -1106,6 +1285,7 @@ std::string jit_compiler::cpu(const std::string& _cpu)
 jit_compiler::jit_compiler(const std::unordered_map<std::string, u64>& _link, const std::string& _cpu, u32 flags)
 	: m_link(_link)
 	, m_cpu(cpu(_cpu))
+	, m_compress_objects(!(flags & 0x4))
 {
 	std::string result;
 
@@ -1168,7 +1348,7 @@ jit_compiler::~jit_compiler()
 
 void jit_compiler::add(std::unique_ptr<llvm::Module> _module, const std::string& path)
 {
-	ObjectCache cache{path};
+	ObjectCache cache{path, m_compress_objects};
 	m_engine->setObjectCache(&cache);
 
 	const auto ptr = _module.get();
@@ -1198,11 +1378,9 @@ void jit_compiler::add(std::unique_ptr<llvm::Module> _module)
 
 void jit_compiler::add(const std::string& path)
 {
-	auto cache = ObjectCache::load(path);
-
-	if (auto object_file = llvm::object::ObjectFile::createObjectFile(*cache))
+	if (auto cache = load(path))
 	{
-		m_engine->addObjectFile( std::move(*object_file) );
+		add(std::move(cache));
 	}
 	else
 	{
@@ -1210,22 +1388,40 @@ void jit_compiler::add(const std::string& path)
 	}
 }
 
-bool jit_compiler::check(const std::string& path)
+void jit_compiler::add(std::unique_ptr<llvm::MemoryBuffer> object)
+{
+	if (auto object_file = llvm::object::ObjectFile::createObjectFile(*object))
+	{
+		// Sections are copied and relocated when the object is added, the buffer is released on return
+		m_engine->addObjectFile(std::move(*object_file));
+	}
+	else
+	{
+		jit_log.error("ObjectCache: Adding failed: %s", object->getBufferIdentifier().str());
+	}
+}
+
+std::unique_ptr<llvm::MemoryBuffer> jit_compiler::load(const std::string& path)
 {
 	if (auto cache = ObjectCache::load(path))
 	{
-		if (auto object_file = llvm::object::ObjectFile::createObjectFile(*cache))
+		if (llvm::object::ObjectFile::createObjectFile(*cache))
 		{
-			return true;
+			return cache;
 		}
 
-		if (fs::remove_file(path))
+		if (fs::remove_file(path) || fs::remove_file(path + ".gz"))
 		{
 			jit_log.error("ObjectCache: Removed damaged file: %s", path);
 		}
 	}
 
-	return false;
+	return nullptr;
+}
+
+bool jit_compiler::check(const std::string& path)
+{
+	return load(path) != nullptr;
 }
 
 void jit_compiler::fin()
@@ -43,6 +43,22 @@ struct jit_runtime final : asmjit::HostRuntime
 	// Allocate memory
 	static u8* alloc(std::size_t size, uint align, bool exec = true) noexcept;
 
+	// Allocate executable memory which can be given back with retire() (rounded up to a size class, 16-byte aligned)
+	static u8* alloc_reclaimable(std::size_t size) noexcept;
+
+	// Give back memory from alloc_reclaimable(), returns false for any other pointer
+	// Retired memory is not reused until reclaim() is called with a newer epoch
+	static bool retire(const void* ptr) noexcept;
+
+	// Start a new epoch, memory retired before it can be passed to reclaim() once no thread can execute it
+	static u64 next_epoch() noexcept;
+
+	// Reuse memory retired before the given epoch
+	static void reclaim(u64 epoch) noexcept;
+
+	// Get the amount of retired memory waiting for reclaim()
+	static u64 get_retired_size() noexcept;
+
 	// Should be called at least once after global initialization
 	static void initialize();
 
@@ -122,6 +138,7 @@ FT build_function_asm(F&& builder)
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/Support/MemoryBuffer.h"
 #ifdef _MSC_VER
 #pragma warning(pop)
 #else
@@ -147,6 +164,9 @@ class jit_compiler final
 	// Arch
 	std::string m_cpu;
 
+	// Compress cached object files (disabled by flag 0x4)
+	bool m_compress_objects = true;
+
 public:
 	jit_compiler(const std::unordered_map<std::string, u64>& _link, const std::string& _cpu, u32 flags = 0);
 	~jit_compiler();
@@ -171,6 +191,12 @@ public:
 	// Add object (path to obj file)
 	void add(const std::string& path);
 
+	// Add object (loaded obj file)
+	void add(std::unique_ptr<llvm::MemoryBuffer> object);
+
+	// Load and validate object file (thread-safe), returns nullptr if missing or damaged
+	static std::unique_ptr<llvm::MemoryBuffer> load(const std::string& path);
+
 	// Check object file
 	static bool check(const std::string& path);
 
@@ -7,6 +7,7 @@
 #include "Thread.h"
 #include "sysinfo.h"
 #include <typeinfo>
+#include <map>
 #include <thread>
 #include <sstream>
 
@@ -81,6 +82,9 @@ LOG_CHANNEL(vm_log, "VM");
 thread_local u64 g_tls_fault_all = 0;
 thread_local u64 g_tls_fault_rsx = 0;
 thread_local u64 g_tls_fault_spu = 0;
+#if !defined(_WIN32) && defined(RUSAGE_THREAD)
+thread_local struct ::rusage g_tls_usage_start{}; // Resource usage of the host thread when the current context started
+#endif
 extern thread_local std::string(*g_tls_log_prefix)();
 
 template <>
@@ -1821,13 +1825,189 @@ thread_local DECLARE(thread_ctrl::g_tls_error_callback) = nullptr;
 
 DECLARE(thread_ctrl::g_native_core_layout) { native_core_arrangement::undefined };
 
-void thread_base::start(native_entry entry)
+namespace
+{
+	// Host threads parked after their context finished, waiting to be rebound to another one
+	struct thread_pool_t
+	{
+		static constexpr u32 max_parked = 64;
+
+		// Parked host threads idle for this long exit
+		static constexpr u64 idle_timeout_ns = 10'000'000'000;
+
+#ifndef _WIN32
+		// Scheduling state of the thread starting a context, a new host thread would inherit it
+		struct sched_state_t
+		{
+			int policy = SCHED_OTHER;
+			::sched_param param{};
+#ifdef __linux__
+			cpu_set_t affinity{};
+#endif
+
+			void save()
+			{
+				pthread_getschedparam(pthread_self(), &policy, &param);
+#ifdef __linux__
+				pthread_getaffinity_np(pthread_self(), sizeof(affinity), &affinity);
+#endif
+			}
+
+			void apply() const
+			{
+				pthread_setschedparam(pthread_self(), policy, &param);
+#ifdef __linux__
+				pthread_setaffinity_np(pthread_self(), sizeof(affinity), &affinity);
+#endif
+			}
+		};
+#endif
+
+		struct slot_t
+		{
+			atomic_t<thread_base*> task{nullptr};
+			void* entry = nullptr;
+			std::uintptr_t handle = 0;
+#ifndef _WIN32
+			sched_state_t sched{};
+#endif
+		};
+
+		// Slots holding a parked thread which can be taken
+		atomic_t<u64> parked{0};
+
+		// Slots reserved by a parked or waking thread
+		atomic_t<u64> used{0};
+
+		std::array<slot_t, max_parked> slots{};
+
+		atomic_t<u64> created{0};
+		atomic_t<u64> reused{0};
+		atomic_t<u64> create_ns{0};
+		atomic_t<u64> reuse_ns{0};
+	};
+
+	thread_pool_t s_thread_pool;
+
+	u64 get_steady_ns()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+#ifndef _WIN32
+// Entry point of pooled host threads: runs the first context, then keeps parking until idle for too long
+static void* thread_pool_entry(void* arg)
+{
+	using entry_t = void*(*)(void*);
+
+	std::unique_ptr<std::pair<entry_t, thread_base*>> first(static_cast<std::pair<entry_t, thread_base*>*>(arg));
+
+	entry_t entry = first->first;
+	thread_base* task = first->second;
+	first.reset();
+
+	while (true)
+	{
+		entry(task);
+
+		// Find a free slot
+		u32 pos = thread_pool_t::max_parked;
+
+		for (u64 used = s_thread_pool.used; used != umax; used = s_thread_pool.used)
+		{
+			const u32 bit = std::countr_one(used);
+
+			if (!s_thread_pool.used.bts(bit))
+			{
+				pos = bit;
+				break;
+			}
+		}
+
+		if (pos == thread_pool_t::max_parked)
+		{
+			// Too many parked threads
+			return nullptr;
+		}
+
+		auto& slot = s_thread_pool.slots[pos];
+		slot.handle = reinterpret_cast<std::uintptr_t>(pthread_self());
+		slot.task.release(nullptr);
+		s_thread_pool.parked.bts(pos);
+
+		const u64 park_time = get_steady_ns();
+
+		while (!slot.task)
+		{
+			slot.task.wait(nullptr, atomic_wait_timeout{thread_pool_t::idle_timeout_ns});
+
+			if (!slot.task && get_steady_ns() - park_time >= thread_pool_t::idle_timeout_ns && s_thread_pool.parked.btr(pos))
+			{
+				// Nobody took this thread in time
+				s_thread_pool.used.btr(pos);
+				return nullptr;
+			}
+		}
+
+		task = slot.task.load();
+		entry = reinterpret_cast<entry_t>(slot.entry);
+
+		// Reset priority and affinity which the previous context may have changed
+		slot.sched.apply();
+		s_thread_pool.used.btr(pos);
+	}
+}
+#endif
+
+void thread_base::start(native_entry entry, bool pooled)
 {
 #ifdef _WIN32
+	// Not implemented
+	static_cast<void>(pooled);
+
 	m_thread = ::_beginthreadex(nullptr, 0, entry, this, CREATE_SUSPENDED, nullptr);
 	verify("thread_ctrl::start" HERE), m_thread, ::ResumeThread(reinterpret_cast<HANDLE>(+m_thread)) != -1;
 #else
-	verify("thread_ctrl::start" HERE), pthread_create(reinterpret_cast<pthread_t*>(&m_thread.raw()), nullptr, entry, this) == 0;
+	if (!pooled)
+	{
+		verify("thread_ctrl::start" HERE), pthread_create(reinterpret_cast<pthread_t*>(&m_thread.raw()), nullptr, entry, this) == 0;
+		return;
+	}
+
+	m_pooled = true;
+
+	const u64 start_time = get_steady_ns();
+
+	// Try to rebind a parked host thread
+	for (u64 bits = s_thread_pool.parked; bits; bits = s_thread_pool.parked)
+	{
+		const u32 pos = std::countr_zero(bits);
+
+		if (s_thread_pool.parked.btr(pos))
+		{
+			auto& slot = s_thread_pool.slots[pos];
+			m_thread.release(slot.handle);
+			slot.entry = reinterpret_cast<void*>(entry);
+			slot.sched.save();
+			slot.task.release(this);
+			slot.task.notify_one();
+
+			s_thread_pool.reused++;
+			s_thread_pool.reuse_ns += get_steady_ns() - start_time;
+			return;
+		}
+	}
+
+	const auto arg = new std::pair<void*(*)(void*), thread_base*>(entry, this);
+
+	pthread_t handle;
+	verify("thread_ctrl::start" HERE), pthread_create(&handle, nullptr, thread_pool_entry, arg) == 0;
+	pthread_detach(handle);
+	m_thread.release(reinterpret_cast<std::uintptr_t>(handle));
+
+	s_thread_pool.created++;
+	s_thread_pool.create_ns += get_steady_ns() - start_time;
 #endif
 }
 
@@ -1836,6 +2016,14 @@ void thread_base::initialize(void (*error_cb)(), bool(*wait_cb)(const void*))
 	// Initialize TLS variables
 	thread_ctrl::g_tls_this_thread = this;
 
+	// Host threads may be reused
+	g_tls_fault_all = 0;
+	g_tls_fault_rsx = 0;
+	g_tls_fault_spu = 0;
+#if !defined(_WIN32) && defined(RUSAGE_THREAD)
+	::getrusage(RUSAGE_THREAD, &g_tls_usage_start);
+#endif
+
 	thread_ctrl::g_tls_error_callback = error_cb;
 
 	// Initialize atomic wait callback
@@ -1913,11 +2101,15 @@ bool thread_base::finalize(thread_state result_state) noexcept
 	const u64 cycles = 0; // Not supported
 	struct ::rusage stats{};
 	::getrusage(RUSAGE_THREAD, &stats);
-	const u64 time = (stats.ru_utime.tv_sec + stats.ru_stime.tv_sec) * 1000000000ull + (stats.ru_utime.tv_usec + stats.ru_stime.tv_usec) * 1000ull;
-	const u64 fsoft = stats.ru_minflt;
-	const u64 fhard = stats.ru_majflt;
-	const u64 ctxvol = stats.ru_nvcsw;
-	const u64 ctxinv = stats.ru_nivcsw;
+
+	// Host threads may be reused, only report the usage since the context started
+	const auto& start = g_tls_usage_start;
+	const auto get_ns = [](const ::rusage& r) { return (r.ru_utime.tv_sec + r.ru_stime.tv_sec) * 1000000000ull + (r.ru_utime.tv_usec + r.ru_stime.tv_usec) * 1000ull; };
+	const u64 time = get_ns(stats) - get_ns(start);
+	const u64 fsoft = stats.ru_minflt - start.ru_minflt;
+	const u64 fhard = stats.ru_majflt - start.ru_majflt;
+	const u64 ctxvol = stats.ru_nvcsw - start.ru_nvcsw;
+	const u64 ctxinv = stats.ru_nivcsw - start.ru_nivcsw;
 #else
 	const u64 cycles = 0;
 	const u64 time = 0;
@@ -2040,7 +2232,7 @@ thread_base::thread_base(std::string_view name)
 
 thread_base::~thread_base()
 {
-	if (m_thread)
+	if (m_thread && !m_pooled)
 	{
 #ifdef _WIN32
 		CloseHandle(reinterpret_cast<HANDLE>(m_thread.raw()));
@@ -2366,6 +2558,232 @@ u64 thread_ctrl::get_affinity_mask(thread_class group)
 	return UINT64_MAX;
 }
 
+#ifdef __linux__
+namespace
+{
+	std::string read_sysfs_line(const std::string& path)
+	{
+		std::string line;
+
+		// Sysfs files report a fixed size, read what is actually there
+		if (fs::file file{path})
+		{
+			line.resize(4096);
+			line.resize(file.read(line.data(), line.size()));
+			line.erase(line.find_last_not_of(" \n") + 1);
+		}
+
+		return line;
+	}
+
+	// Host CPUs grouped by shared last level cache and NUMA node, with a CPU set for each thread class
+	struct cpu_topology
+	{
+		struct cache_group
+		{
+			std::vector<u32> cpus;
+			u32 node = 0;
+		};
+
+		std::vector<cache_group> groups;
+
+		std::array<std::vector<u32>, 4> placement;
+
+		cpu_topology()
+		{
+			cpu_set_t allowed;
+			CPU_ZERO(&allowed);
+
+			if (sched_getaffinity(0, sizeof(allowed), &allowed))
+			{
+				return;
+			}
+
+			std::map<std::string, std::size_t> group_index;
+
+			for (u32 cpu = 0; cpu < CPU_SETSIZE; cpu++)
+			{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+				if (!CPU_ISSET(cpu, &allowed))
+#pragma GCC diagnostic pop
+				{
+					continue;
+				}
+
+				const std::string base = fmt::format("/sys/devices/system/cpu/cpu%u/", cpu);
+
+				// Only shared L3 caches are considered, L2 is private to a core (or a module) on most hosts
+				const std::string shared = read_sysfs_line(base + "cache/index3/shared_cpu_list");
+
+				if (shared.empty() || read_sysfs_line(base + "cache/index3/level") != "3")
+				{
+					// Unknown topology, keep the default masks
+					groups.clear();
+					return;
+				}
+
+				auto [it, inserted] = group_index.emplace(shared, groups.size());
+
+				if (inserted)
+				{
+					auto& group = groups.emplace_back();
+
+					for (const auto& dir : fs::dir{base})
+					{
+						if (dir.name.starts_with("node") && dir.name.size() > 4)
+						{
+							group.node = static_cast<u32>(std::strtoul(dir.name.c_str() + 4, nullptr, 10));
+							break;
+						}
+					}
+				}
+
+				groups[it->second].cpus.push_back(cpu);
+			}
+
+			if (groups.empty())
+			{
+				return;
+			}
+
+			// Stay within the NUMA node of the first allowed cache group
+			std::vector<const cache_group*> local;
+
+			for (const auto& group : groups)
+			{
+				if (group.node == groups[0].node)
+				{
+					local.push_back(&group);
+				}
+			}
+
+			std::vector<u32> local_cpus;
+
+			for (auto group : local)
+			{
+				local_cpus.insert(local_cpus.end(), group->cpus.begin(), group->cpus.end());
+			}
+
+			placement[static_cast<u32>(thread_class::general)] = local_cpus;
+
+			if (local.size() == 1)
+			{
+				// Single shared cache, nothing to separate
+				placement[static_cast<u32>(thread_class::rsx)] = local_cpus;
+				placement[static_cast<u32>(thread_class::ppu)] = local_cpus;
+				placement[static_cast<u32>(thread_class::spu)] = local_cpus;
+				return;
+			}
+
+			// RSX gets its own cache group, PPU and SPU threads share the next ones so SPU groups keep L3 locality
+			placement[static_cast<u32>(thread_class::rsx)] = local[0]->cpus;
+			placement[static_cast<u32>(thread_class::ppu)] = local[1]->cpus;
+			placement[static_cast<u32>(thread_class::spu)] = local.size() > 2 ? local[2]->cpus : local[1]->cpus;
+
+			for (std::size_t i = 3; i < local.size(); i++)
+			{
+				auto& spu = placement[static_cast<u32>(thread_class::spu)];
+				spu.insert(spu.end(), local[i]->cpus.begin(), local[i]->cpus.end());
+			}
+		}
+
+		// Only worth overriding the default masks when there is more than one shared L3 group
+		bool is_useful() const
+		{
+			if (groups.size() <= 1)
+			{
+				return false;
+			}
+
+			for (const auto& group : groups)
+			{
+				if (group.cpus.size() <= 1)
+				{
+					// Would pin whole thread classes to a single core
+					return false;
+				}
+			}
+
+			return true;
+		}
+	};
+
+	const cpu_topology& get_cpu_topology()
+	{
+		static const cpu_topology s_topology = []()
+		{
+			cpu_topology result;
+
+			std::string groups_info;
+
+			for (const auto& group : result.groups)
+			{
+				fmt::append(groups_info, "\n[node %u: %u cpus (%u-%u)]", group.node, group.cpus.size(), group.cpus.front(), group.cpus.back());
+			}
+
+			sig_log.notice("Host CPU topology: %u cache groups:%s", result.groups.size(), groups_info);
+
+			constexpr std::array<const char*, 4> names{"General", "RSX", "SPU", "PPU"};
+
+			for (u32 i = 0; i < names.size(); i++)
+			{
+				std::string cpus;
+
+				for (u32 cpu : result.placement[i])
+				{
+					fmt::append(cpus, "%s%u", cpus.empty() ? "" : ",", cpu);
+				}
+
+				sig_log.notice("Thread placement: %s -> [%s]", names[i], cpus);
+			}
+
+			return result;
+		}();
+
+		return s_topology;
+	}
+}
+#endif
+
+void thread_ctrl::set_thread_affinity(thread_class group)
+{
+#ifdef __linux__
+	detect_cpu_layout();
+
+	const auto thread_count = std::thread::hardware_concurrency();
+
+	// Use the cache topology on hosts without a hand-tuned layout, or on hosts which cannot be described with a u64 mask
+	if (g_native_core_layout != native_core_arrangement::amd_ccx || thread_count > 64)
+	{
+		const auto& topology = get_cpu_topology();
+
+		if (const auto& cpus = topology.placement[static_cast<u32>(group)]; topology.is_useful() && !cpus.empty())
+		{
+			cpu_set_t cs;
+			CPU_ZERO(&cs);
+
+			for (u32 cpu : cpus)
+			{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+				CPU_SET(cpu, &cs);
+#pragma GCC diagnostic pop
+			}
+
+			if (int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cs))
+			{
+				sig_log.error("Failed to set thread affinity (%u cpus): error %d.", cpus.size(), err);
+			}
+
+			return;
+		}
+	}
+#endif
+
+	set_thread_affinity_mask(get_affinity_mask(group));
+}
+
 void thread_ctrl::set_native_priority(int priority)
 {
 #ifdef _WIN32
@@ -2513,3 +2931,8 @@ u64 thread_ctrl::get_thread_affinity_mask()
 	return -1;
 #endif
 }
+
+thread_pool_stats thread_ctrl::get_pool_stats()
+{
+	return {s_thread_pool.created, s_thread_pool.reused, s_thread_pool.create_ns, s_thread_pool.reuse_ns};
+}
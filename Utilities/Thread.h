@@ -87,6 +87,22 @@ struct thread_thread_name : std::bool_constant<false> {};
 template <typename T>
 struct thread_thread_name<T, std::void_t<decltype(named_thread<T>::thread_name)>> : std::bool_constant<true> {};
 
+// Contexts declaring thread_pooled = true may run on a reused host thread
+template <typename T, typename = void>
+struct thread_thread_pooled : std::bool_constant<false> {};
+
+template <typename T>
+struct thread_thread_pooled<T, std::void_t<decltype(T::thread_pooled)>> : std::bool_constant<T::thread_pooled> {};
+
+// Host thread pool statistics
+struct thread_pool_stats
+{
+	u64 created; // Host threads created for pooled contexts
+	u64 reused;  // Parked host threads rebound to a new context
+	u64 create_ns; // Total time spent creating host threads
+	u64 reuse_ns; // Total time spent waking parked host threads
+};
+
 // Thread base class
 class thread_base
 {
@@ -115,8 +131,11 @@ class thread_base
 	//
 	atomic_t<u64> m_cycles = 0;
 
-	// Start thread
-	void start(native_entry);
+	// Set if the host thread is owned by the thread pool
+	bool m_pooled = false;
+
+	// Start thread, possibly on a parked host thread
+	void start(native_entry, bool pooled);
 
 	// Called at the thread start
 	void initialize(void (*error_cb)(), bool(*wait_cb)(const void*));
@@ -249,12 +268,18 @@ public:
 	// Sets the preferred affinity mask for this thread
 	static void set_thread_affinity_mask(u64 mask);
 
+	// Sets the affinity of this thread for its class, using the host cache topology where available
+	static void set_thread_affinity(thread_class group);
+
 	// Get process affinity mask
 	static u64 get_process_affinity_mask();
 
 	// Miscellaneous
 	static u64 get_thread_affinity_mask();
 
+	// Get host thread pool statistics
+	static thread_pool_stats get_pool_stats();
+
 private:
 	// Miscellaneous
 	static const u64 process_affinity_mask;
@@ -345,7 +370,7 @@ public:
 		: Context()
 		, thread(Context::thread_name)
 	{
-		thread::start(&named_thread::entry_point);
+		thread::start(&named_thread::entry_point, thread_thread_pooled<Context>());
 	}
 
 	// Normal forwarding constructor
@@ -354,7 +379,7 @@ public:
 		: Context(std::forward<Args>(args)...)
 		, thread(name)
 	{
-		thread::start(&named_thread::entry_point);
+		thread::start(&named_thread::entry_point, thread_thread_pooled<Context>());
 	}
 
 	// Lambda constructor, also the implicit deduction guide candidate
@@ -362,7 +387,7 @@ public:
 		: Context(std::forward<Context>(f))
 		, thread(name)
 	{
-		thread::start(&named_thread::entry_point);
+		thread::start(&named_thread::entry_point, thread_thread_pooled<Context>());
 	}
 
 	named_thread(const named_thread&) = delete;
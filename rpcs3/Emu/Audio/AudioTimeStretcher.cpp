@@ -0,0 +1,200 @@
+﻿#include "stdafx.h"
+#include "AudioTimeStretcher.h"
+
+#include <cmath>
+
+static inline f32 sse_hsum_ps(__m128 v)
+{
+	v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+	v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+	return _mm_cvtss_f32(v);
+}
+
+AudioTimeStretcher::AudioTimeStretcher(u32 channels)
+	: m_channels(channels)
+{
+	verify(HERE), channels == 2 || channels == 8;
+
+	m_tail.resize(overlap_frames * channels);
+}
+
+f32 AudioTimeStretcher::set_tempo(f32 tempo)
+{
+	m_tempo = std::clamp(tempo, min_tempo, max_tempo);
+	return m_tempo;
+}
+
+u32 AudioTimeStretcher::find_best_offset(const float* input) const
+{
+	// Normalized cross-correlation of the previous tail against every candidate position in the seek window
+	const u32 count = overlap_frames * m_channels;
+
+	f32 best_score = -INFINITY;
+	u32 best_offset = 0;
+
+	for (u32 offset = 0; offset < seek_frames; offset++)
+	{
+		const float* segment = input + offset * m_channels;
+
+		__m128 corr = _mm_setzero_ps();
+		__m128 norm = _mm_setzero_ps();
+
+		for (u32 i = 0; i < count; i += 4)
+		{
+			const __m128 value = _mm_loadu_ps(segment + i);
+			corr = _mm_add_ps(corr, _mm_mul_ps(value, _mm_loadu_ps(m_tail.data() + i)));
+			norm = _mm_add_ps(norm, _mm_mul_ps(value, value));
+		}
+
+		const f32 score = sse_hsum_ps(corr) / std::sqrt(sse_hsum_ps(norm) + 1e-9f);
+
+		if (score > best_score)
+		{
+			best_score = score;
+			best_offset = offset;
+		}
+	}
+
+	return best_offset;
+}
+
+void AudioTimeStretcher::crossfade(const float* input)
+{
+	const std::size_t pos = m_output.size();
+	m_output.resize(pos + overlap_frames * m_channels);
+
+	float* out = m_output.data() + pos;
+
+	for (u32 frame = 0; frame < overlap_frames; frame++)
+	{
+		const __m128 weight = _mm_set1_ps((frame + 0.5f) / overlap_frames);
+
+		for (u32 ch = 0; ch < m_channels; ch += 2)
+		{
+			// Two channels at a time, the channel count is always even
+			const u32 i = frame * m_channels + ch;
+			const __m128 prev = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const f64*>(m_tail.data() + i)));
+			const __m128 next = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const f64*>(input + i)));
+			const __m128 result = _mm_add_ps(prev, _mm_mul_ps(_mm_sub_ps(next, prev), weight));
+			_mm_store_sd(reinterpret_cast<f64*>(out + i), _mm_castps_pd(result));
+		}
+	}
+}
+
+void AudioTimeStretcher::process(const float* in, u32 frames)
+{
+	m_input.insert(m_input.end(), in, in + frames * m_channels);
+
+	while (true)
+	{
+		const u32 input_frames = ::size32(m_input) / m_channels;
+
+		if (m_tempo == 1.0f)
+		{
+			if (m_has_tail)
+			{
+				// Blend into the unstretched stream once and switch to passthrough
+				const u32 pos = static_cast<u32>(m_input_pos);
+
+				if (input_frames < pos + seek_frames + overlap_frames)
+				{
+					break;
+				}
+
+				const float* base = m_input.data() + pos * m_channels;
+				const u32 offset = find_best_offset(base);
+				crossfade(base + offset * m_channels);
+				m_emitted_pos = pos + offset + overlap_frames;
+				m_has_tail = false;
+			}
+
+			// Output only the frames which were not output yet
+			m_output.insert(m_output.end(), m_input.data() + m_emitted_pos * m_channels, m_input.data() + m_input.size());
+			m_emitted_pos = input_frames;
+			m_passthrough = true;
+			break;
+		}
+
+		if (m_passthrough)
+		{
+			// The first segment continues exactly where the passed through stream ended
+			m_passthrough = false;
+			m_input_pos = m_emitted_pos;
+		}
+
+		const u32 pos = static_cast<u32>(m_input_pos);
+
+		// The first segment is not blended, so it doesn't need the seek window
+		if (input_frames < pos + (m_has_tail ? seek_frames : 0) + sequence_frames)
+		{
+			break;
+		}
+
+		const float* base = m_input.data() + pos * m_channels;
+		const float* segment = base;
+
+		if (!m_has_tail)
+		{
+			// Nothing to blend with at the start of the stream
+			m_output.insert(m_output.end(), segment, segment + (sequence_frames - overlap_frames) * m_channels);
+			m_has_tail = true;
+		}
+		else
+		{
+			segment += find_best_offset(base) * m_channels;
+			crossfade(segment);
+			m_output.insert(m_output.end(), segment + overlap_frames * m_channels, segment + (sequence_frames - overlap_frames) * m_channels);
+		}
+
+		std::copy(segment + (sequence_frames - overlap_frames) * m_channels, segment + sequence_frames * m_channels, m_tail.begin());
+
+		m_input_pos += (sequence_frames - overlap_frames) * m_tempo;
+	}
+
+	// Drop input which is no longer needed once it makes up at least half of the buffer (amortizes the move)
+	const u32 input_frames = ::size32(m_input) / m_channels;
+
+	// The search position may be ahead of the input with fast tempo
+	const u32 consumed = std::min(m_passthrough ? m_emitted_pos : static_cast<u32>(m_input_pos), input_frames);
+
+	if (consumed && consumed * m_channels * 2 >= m_input.size())
+	{
+		m_input.erase(m_input.begin(), m_input.begin() + consumed * m_channels);
+		m_input_pos = std::max(m_input_pos - consumed, 0.0);
+		m_emitted_pos -= std::min(m_emitted_pos, consumed);
+	}
+}
+
+bool AudioTimeStretcher::read(float* out, u32 frames)
+{
+	const std::size_t count = frames * m_channels;
+
+	if (m_output.size() - m_output_pos < count)
+	{
+		return false;
+	}
+
+	std::copy_n(m_output.data() + m_output_pos, count, out);
+	m_output_pos += count;
+
+	// Drop read output once it makes up at least half of the buffer
+	if (m_output_pos * 2 >= m_output.size())
+	{
+		m_output.erase(m_output.begin(), m_output.begin() + m_output_pos);
+		m_output_pos = 0;
+	}
+
+	return true;
+}
+
+void AudioTimeStretcher::reset()
+{
+	m_input.clear();
+	m_output.clear();
+	m_has_tail = false;
+	m_passthrough = true;
+	m_input_pos = 0.0;
+	m_emitted_pos = 0;
+	m_output_pos = 0;
+	m_tempo = 1.0f;
+}
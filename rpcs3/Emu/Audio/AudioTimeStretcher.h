@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Utilities/types.h"
+
+#include <vector>
+
+// WSOLA time stretcher for interleaved float samples, changes the playback speed without changing the pitch
+class AudioTimeStretcher
+{
+	const u32 m_channels;
+
+	std::vector<float> m_input;  // Pending input frames (consumed frames are compacted occasionally)
+	std::vector<float> m_output; // Stretched frames, read from m_output_pos
+	std::vector<float> m_tail;   // Overlap region of the previous segment
+
+	bool m_has_tail = false;
+	bool m_passthrough = true; // Unstretched output
+	f64 m_input_pos = 0.0; // Segment search position in m_input while stretching (in frames)
+	u32 m_emitted_pos = 0; // End of the frames in m_input which were already output in passthrough (in frames)
+	std::size_t m_output_pos = 0; // Read position in m_output (in samples)
+	f32 m_tempo = 1.0f;
+
+	u32 find_best_offset(const float* input) const;
+	void crossfade(const float* input);
+
+public:
+	static constexpr u32 sequence_frames = 1024;
+	static constexpr u32 overlap_frames = 256;
+	static constexpr u32 seek_frames = 256;
+
+	static constexpr f32 min_tempo = 0.25f;
+	static constexpr f32 max_tempo = 2.0f;
+
+	AudioTimeStretcher(u32 channels);
+
+	// Input frames consumed per output frame, returns the applied value
+	f32 set_tempo(f32 tempo);
+	f32 get_tempo() const { return m_tempo; }
+
+	void process(const float* in, u32 frames);
+
+	// Reads exactly the requested number of frames, returns false if not enough are available
+	bool read(float* out, u32 frames);
+
+	void reset();
+};
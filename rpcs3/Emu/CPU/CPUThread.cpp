@@ -330,7 +330,7 @@ void cpu_thread::operator()()
 
 	if (g_cfg.core.thread_scheduler_enabled)
 	{
-		thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(id_type() == 1 ? thread_class::ppu : thread_class::spu));
+		thread_ctrl::set_thread_affinity(id_type() == 1 ? thread_class::ppu : thread_class::spu);
 	}
 
 	if (g_cfg.core.lower_spu_priority && id_type() == 2)
@@ -389,15 +389,16 @@ void cpu_thread::operator()()
 
 	static thread_local struct thread_cleanup_t
 	{
-		cpu_thread* _this;
-		u64 slot;
+		cpu_thread* _this = nullptr;
+		u64 slot = 0;
 		std::string name;
 
-		thread_cleanup_t(cpu_thread* _this, u64 slot)
-			: _this(_this)
-			, slot(slot)
-			, name(thread_ctrl::get_name())
+		// Host thread may be reused for several cpu threads (see thread_pooled)
+		void init(cpu_thread* _this, u64 slot)
 		{
+			this->_this = _this;
+			this->slot = slot;
+			this->name = thread_ctrl::get_name();
 		}
 
 		void cleanup()
@@ -410,10 +411,17 @@ void cpu_thread::operator()()
 			if (auto ptr = vm::g_tls_locked)
 			{
 				ptr->compare_and_swap(_this, nullptr);
+				vm::g_tls_locked = nullptr;
 			}
 
 			g_fxo->get<cpu_counter>()->remove(_this, slot);
 
+			if (g_tls_current_cpu_thread == _this)
+			{
+				// The host thread may be reused for another context
+				g_tls_current_cpu_thread = nullptr;
+			}
+
 			_this = nullptr;
 		}
 
@@ -425,7 +433,9 @@ void cpu_thread::operator()()
 				cleanup();
 			}
 		}
-	} cleanup{this, array_slot};
+	} cleanup;
+
+	cleanup.init(this, array_slot);
 
 	// Check thread status
 	while (!(state & (cpu_flag::exit + cpu_flag::dbg_global_stop)) && thread_ctrl::state() != thread_state::aborting)
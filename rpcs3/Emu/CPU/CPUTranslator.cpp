@@ -56,6 +56,17 @@ void cpu_translator::initialize(llvm::LLVMContext& context, llvm::ExecutionEngin
 		cpu == "tigerlake")
 	{
 		m_use_fma = true;
+		m_use_avx512 = true;
+	}
+
+	// Test AVX-512 VBMI feature (TODO)
+	if (cpu == "cannonlake" ||
+		cpu == "icelake" ||
+		cpu == "icelake-client" ||
+		cpu == "icelake-server" ||
+		cpu == "tigerlake")
+	{
+		m_use_vbmi = true;
 	}
 }
 
@@ -2423,6 +2423,12 @@ protected:
 	// Allow FMA
 	bool m_use_fma = false;
 
+	// Allow AVX-512 (F, BW, DQ, VL) intrinsics
+	bool m_use_avx512 = false;
+
+	// Allow AVX-512 VBMI intrinsics
+	bool m_use_vbmi = false;
+
 	// IR builder
 	llvm::IRBuilder<>* m_ir;
 
@@ -2760,6 +2766,32 @@ public:
 		return result;
 	}
 
+	// Bitwise ternary logic (AVX-512), imm is the truth table for (a, b, c) bits
+	template <typename T1, typename T2, typename T3>
+	value_t<u32[4]> vpternlogd(T1 a, T2 b, T3 c, u8 imm)
+	{
+		value_t<u32[4]> result;
+
+		const auto av = bitcast<u32[4]>(a.eval(m_ir));
+		const auto bv = bitcast<u32[4]>(b.eval(m_ir));
+		const auto cv = bitcast<u32[4]>(c.eval(m_ir));
+		result.value = m_ir->CreateCall(get_intrinsic(llvm::Intrinsic::x86_avx512_pternlog_d_128), {av, bv, cv, m_ir->getInt32(imm)});
+		return result;
+	}
+
+	// Two-source byte permutation (AVX-512 VBMI), index bit 4 selects b, bits 5-7 are ignored
+	template <typename T1, typename T2, typename T3>
+	value_t<u8[16]> vpermi2b(T1 a, T2 index, T3 b)
+	{
+		value_t<u8[16]> result;
+
+		const auto av = a.eval(m_ir);
+		const auto iv = index.eval(m_ir);
+		const auto bv = b.eval(m_ir);
+		result.value = m_ir->CreateCall(get_intrinsic(llvm::Intrinsic::x86_avx512_vpermi2var_qi_128), {av, iv, bv});
+		return result;
+	}
+
 	template <typename T1, typename T2>
 	value_t<u8[16]> pshufb(T1 a, T2 b)
 	{
@@ -4,6 +4,7 @@
 #include "Emu/Cell/lv2/sys_process.h"
 #include "Emu/Cell/lv2/sys_event.h"
 #include "cellAudio.h"
+#include "Utilities/sysinfo.h"
 #include <atomic>
 #include <cmath>
 
@@ -49,9 +50,9 @@ cell_audio_config::cell_audio_config()
 	{
 		cellAudio.error("Audio backend %s does not support buffering, this option will be ignored.", backend->GetName());
 	}
-	if (raw_time_stretching_enabled && !time_stretching_enabled)
+	if (g_cfg.audio.enable_time_stretching && !time_stretching_enabled)
 	{
-		cellAudio.error("Audio backend %s does not support time stretching, this option will be ignored.", backend->GetName());
+		cellAudio.error("Time stretching requires buffering to be enabled, this option will be ignored.");
 	}
 }
 
@@ -79,6 +80,19 @@ audio_ringbuffer::audio_ringbuffer(cell_audio_config& _cfg)
 		m_dump.reset(new AudioDumper(cfg.audio_channels));
 	}
 
+	// Init time stretcher if enabled
+	if (cfg.time_stretching_enabled)
+	{
+		m_stretcher = std::make_unique<AudioTimeStretcher>(cfg.audio_channels);
+		m_stretch_buffer.reset(new float[buf_sz]{});
+	}
+
+	// Buffer for the u16 conversion, the ring buffer contents must stay intact for the time stretcher
+	if (g_cfg.audio.convert_to_u16)
+	{
+		m_convert_buffer.reset(new float[buf_sz / 2]{});
+	}
+
 	// Initialize backend
 	{
 		std::string str;
@@ -94,6 +108,11 @@ audio_ringbuffer::audio_ringbuffer(cell_audio_config& _cfg)
 
 audio_ringbuffer::~audio_ringbuffer()
 {
+	if (m_stretch_blocks)
+	{
+		cellAudio.notice("Time stretcher: %llu blocks, %llu cycles/block", m_stretch_blocks, m_stretch_cycles / m_stretch_blocks);
+	}
+
 	if (!backend_open)
 	{
 		return;
@@ -109,14 +128,14 @@ audio_ringbuffer::~audio_ringbuffer()
 
 f32 audio_ringbuffer::set_frequency_ratio(f32 new_ratio)
 {
-	if (!has_capability(AudioBackend::SET_FREQUENCY_RATIO))
+	if (!m_stretcher)
 	{
 		ASSERT(new_ratio == 1.0f);
 		frequency_ratio = 1.0f;
 	}
 	else
 	{
-		frequency_ratio = backend->SetFrequencyRatio(new_ratio);
+		frequency_ratio = m_stretcher->set_tempo(new_ratio);
 		//cellAudio.trace("set_frequency_ratio(%1.2f) -> %1.2f", new_ratio, frequency_ratio);
 	}
 	return frequency_ratio;
@@ -127,7 +146,7 @@ void audio_ringbuffer::enqueue(const float* in_buffer)
 	AUDIT(cur_pos < cfg.num_allocated_buffers);
 
 	// Prepare buffer
-	const void* buf = in_buffer;
+	const float* buf = in_buffer;
 
 	if (buf == nullptr)
 	{
@@ -135,6 +154,48 @@ void audio_ringbuffer::enqueue(const float* in_buffer)
 		cur_pos = (cur_pos + 1) % cfg.num_allocated_buffers;
 	}
 
+	if (!m_stretcher)
+	{
+		enqueue_block(buf);
+		return;
+	}
+
+	// Stretch audio, this may produce zero or more blocks depending on the current ratio
+	const u64 stamp0 = __rdtsc();
+	m_stretcher->process(buf, AUDIO_BUFFER_SAMPLES);
+	m_stretch_cycles += __rdtsc() - stamp0;
+	m_stretch_blocks++;
+
+	while (m_stretcher->read(m_stretch_buffer.get(), AUDIO_BUFFER_SAMPLES))
+	{
+		enqueue_block(m_stretch_buffer.get());
+	}
+}
+
+void audio_ringbuffer::enqueue_block(const float* buf)
+{
+	if (m_convert_buffer && buf != silence_buffer)
+	{
+		// convert the data from float to u16 with clipping:
+		// 2x MULPS
+		// 2x MAXPS (optional)
+		// 2x MINPS (optional)
+		// 2x CVTPS2DQ (converts float to s32)
+		// PACKSSDW (converts s32 to s16 with signed saturation)
+
+		float* out = m_convert_buffer.get();
+
+		for (size_t i = 0; i < buf_sz; i += 8)
+		{
+			const auto scale = _mm_set1_ps(0x8000);
+			_mm_store_ps(out + i / 2, _mm_castsi128_ps(_mm_packs_epi32(
+				_mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(buf + i), scale)),
+				_mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(buf + i + 4), scale)))));
+		}
+
+		buf = out;
+	}
+
 	// Dump audio if enabled
 	if (m_dump)
 	{
@@ -210,11 +271,12 @@ void audio_ringbuffer::flush()
 
 	backend->Flush();
 
-	if (frequency_ratio != 1.0f)
+	if (m_stretcher)
 	{
-		set_frequency_ratio(1.0f);
+		m_stretcher->reset();
 	}
 
+	frequency_ratio = 1.0f;
 	enqueued_samples = 0;
 }
 
@@ -256,7 +318,7 @@ u64 audio_ringbuffer::update()
 		{
 			const u64 play_delta = timestamp - (play_timestamp > update_timestamp ? play_timestamp : update_timestamp);
 
-			const u64 delta_samples_tmp = play_delta * static_cast<u64>(cfg.audio_sampling_rate * frequency_ratio) + last_remainder;
+			const u64 delta_samples_tmp = play_delta * cfg.audio_sampling_rate + last_remainder;
 			last_remainder = delta_samples_tmp % 1'000'000;
 			const u64 delta_samples = delta_samples_tmp / 1'000'000;
 
@@ -442,7 +504,7 @@ void cell_audio_thread::advance(u64 timestamp, bool reset)
 	if (cfg.buffering_enabled)
 	{
 		// Calculate rolling average of enqueued playtime
-		const u64 enqueued_playtime = ringbuffer->get_enqueued_playtime(/* raw */ true);
+		const u64 enqueued_playtime = ringbuffer->get_enqueued_playtime();
 		m_average_playtime = cfg.period_average_alpha * enqueued_playtime + (1.0f - cfg.period_average_alpha) * m_average_playtime;
 		//cellAudio.error("m_average_playtime=%4.2f, enqueued_playtime=%u", m_average_playtime, enqueued_playtime);
 	}
@@ -576,13 +638,10 @@ void cell_audio_thread::operator()()
 
 				if (cfg.time_stretching_enabled)
 				{
-					// Calculate what the playtime is without a frequency ratio
-					const u64 raw_enqueued_playtime = ringbuffer->get_enqueued_playtime(/* raw= */ true);
-
 					//  1.0 means exactly as desired
 					// <1.0 means not as full as desired
 					// >1.0 means more full than desired
-					const f32 desired_duration_rate = raw_enqueued_playtime / desired_duration_adjusted;
+					const f32 desired_duration_rate = enqueued_playtime / desired_duration_adjusted;
 
 					// update frequency ratio if necessary
 					f32 new_ratio = frequency_ratio;
@@ -607,7 +666,6 @@ void cell_audio_thread::operator()()
 					{
 						// ratio changed, calculate new dynamic period
 						frequency_ratio = new_ratio;
-						enqueued_playtime = ringbuffer->get_enqueued_playtime();
 						m_dynamic_period = 0;
 					}
 				}
@@ -761,10 +819,130 @@ void cell_audio_thread::operator()()
 		advance(timestamp);
 	}
 
+	for (u32 i = 0; i < m_mix_stats.size(); i++)
+	{
+		if (const auto& stats = m_mix_stats[i]; stats.blocks)
+		{
+			cellAudio.notice("Mixer: %uch -> %uch port blocks: %u, %u cycles/block", i & 1 ? 8 : 2, i & 2 ? 8 : 2, stats.blocks, stats.cycles / stats.blocks);
+		}
+	}
+
 	// Destroy ringbuffer
 	ringbuffer.reset();
 }
 
+#if defined(_MSC_VER)
+#define AVX2_FUNC
+#else
+#define AVX2_FUNC __attribute__((__target__("avx2")))
+#endif
+
+static const bool s_use_avx2 = utils::has_avx2();
+
+// Byte swaps four big-endian floats
+static inline __m128 sse_bswap_ps(__m128i v)
+{
+	v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+	return _mm_castsi128_ps(_mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xb1), 0xb1));
+}
+
+// Fills the per-frame port level of one block (part of cellAudioSetPortLevel functionality, volume changes are spread over 13ms)
+static void get_port_levels(audio_port& port, float* levels)
+{
+	const auto param = port.level_set.load();
+
+	if (param.inc == 0.0f)
+	{
+		const __m128 level = _mm_set1_ps(port.level);
+
+		for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i += 4)
+		{
+			_mm_store_ps(levels + i, level);
+		}
+
+		return;
+	}
+
+	const bool dec = param.inc < 0.0f;
+	const __m128 start = _mm_set1_ps(port.level);
+	const __m128 inc = _mm_set1_ps(param.inc);
+	const __m128 target = _mm_set1_ps(param.value);
+	__m128 step = _mm_set_ps(4.f, 3.f, 2.f, 1.f);
+
+	for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i += 4)
+	{
+		const __m128 level = _mm_add_ps(start, _mm_mul_ps(inc, step));
+		_mm_store_ps(levels + i, dec ? _mm_max_ps(level, target) : _mm_min_ps(level, target));
+		step = _mm_add_ps(step, _mm_set1_ps(4.f));
+	}
+
+	port.level = levels[AUDIO_BUFFER_SAMPLES - 1];
+
+	if (port.level == param.value)
+	{
+		port.level_set.compare_and_swap(param, { param.value, 0.0f });
+	}
+}
+
+// Converts one guest block to native floats scaled by the port level
+static void scale_port_block(const void* src, const float* levels, float* dst, u32 channels)
+{
+	const auto in = static_cast<const __m128i*>(src);
+
+	if (channels == 2)
+	{
+		for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i += 4)
+		{
+			const __m128 level = _mm_load_ps(levels + i);
+			_mm_store_ps(dst + i * 2 + 0, _mm_mul_ps(sse_bswap_ps(_mm_loadu_si128(in + i / 2 + 0)), _mm_unpacklo_ps(level, level)));
+			_mm_store_ps(dst + i * 2 + 4, _mm_mul_ps(sse_bswap_ps(_mm_loadu_si128(in + i / 2 + 1)), _mm_unpackhi_ps(level, level)));
+		}
+	}
+	else
+	{
+		for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i++)
+		{
+			const __m128 level = _mm_set1_ps(levels[i]);
+			_mm_store_ps(dst + i * 8 + 0, _mm_mul_ps(sse_bswap_ps(_mm_loadu_si128(in + i * 2 + 0)), level));
+			_mm_store_ps(dst + i * 8 + 4, _mm_mul_ps(sse_bswap_ps(_mm_loadu_si128(in + i * 2 + 1)), level));
+		}
+	}
+}
+
+AVX2_FUNC static void scale_port_block_avx2(const void* src, const float* levels, float* dst, u32 channels)
+{
+	const __m256i bswap_mask = _mm256_set_epi8(
+		12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+		12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+	const auto in = static_cast<const __m256i*>(src);
+
+	if (channels == 2)
+	{
+		const __m256i expand = _mm256_set_epi32(3, 3, 2, 2, 1, 1, 0, 0);
+
+		for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i += 4)
+		{
+			const __m256 level = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_load_ps(levels + i)), expand);
+			const __m256 value = _mm256_castsi256_ps(_mm256_shuffle_epi8(_mm256_loadu_si256(in + i / 4), bswap_mask));
+			_mm256_store_ps(dst + i * 2, _mm256_mul_ps(value, level));
+		}
+	}
+	else
+	{
+		for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i++)
+		{
+			const __m256 value = _mm256_castsi256_ps(_mm256_shuffle_epi8(_mm256_loadu_si256(in + i), bswap_mask));
+			_mm256_store_ps(dst + i * 8, _mm256_mul_ps(value, _mm256_set1_ps(levels[i])));
+		}
+	}
+}
+
+static inline void mix_store(float* out, __m128 value, bool first_mix)
+{
+	_mm_store_ps(out, first_mix ? value : _mm_add_ps(_mm_load_ps(out), value));
+}
+
 template <bool DownmixToStereo>
 void cell_audio_thread::mix(float *out_buffer, s32 offset)
 {
@@ -775,153 +953,98 @@ void cell_audio_thread::mix(float *out_buffer, s32 offset)
 
 	bool first_mix = true;
 
+	alignas(32) float levels[AUDIO_BUFFER_SAMPLES];
+	alignas(32) float block[AUDIO_MAX_CHANNELS_COUNT * AUDIO_BUFFER_SAMPLES];
+
 	// mixing
 	for (auto& port : ports)
 	{
 		if (port.state != audio_port_state::started) continue;
 
-		auto buf = port.get_vm_ptr(offset);
-		static const float k = 1.f;
-		static const float minus_3db = 0.707f; /* value taken from
-							  https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf */
-		float& m = port.level;
-
-		// part of cellAudioSetPortLevel functionality
-		// spread port volume changes over 13ms
-		auto step_volume = [](audio_port& port)
+		if (port.num_channels != 2 && port.num_channels != 8)
 		{
-			const auto param = port.level_set.load();
+			fmt::throw_exception("Unknown channel count (port=%u, channel=%d)" HERE, port.number, port.num_channels);
+		}
 
-			if (param.inc != 0.0f)
-			{
-				port.level += param.inc;
-				const bool dec = param.inc < 0.0f;
+		const u64 stamp0 = __rdtsc();
 
-				if ((!dec && param.value - port.level <= 0.0f) || (dec && param.value - port.level >= 0.0f))
-				{
-					port.level = param.value;
-					port.level_set.compare_and_swap(param, { param.value, 0.0f });
-				}
-			}
-		};
+		get_port_levels(port, levels);
+
+		if (s_use_avx2)
+		{
+			scale_port_block_avx2(port.get_vm_ptr(offset), levels, block, port.num_channels);
+		}
+		else
+		{
+			scale_port_block(port.get_vm_ptr(offset), levels, block, port.num_channels);
+		}
+
+		const __m128 zero = _mm_setzero_ps();
 
 		if (port.num_channels == 2)
 		{
-			if (first_mix)
+			if constexpr (DownmixToStereo)
 			{
-				for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 2)
+				for (u32 i = 0; i < out_buffer_sz; i += 4)
 				{
-					step_volume(port);
-
-					const float left  = buf[in + 0] * m;
-					const float right = buf[in + 1] * m;
-
-					out_buffer[out + 0] = left;
-					out_buffer[out + 1] = right;
-
-					if constexpr (!DownmixToStereo)
-					{
-						out_buffer[out + 2] = 0.0f;
-						out_buffer[out + 3] = 0.0f;
-						out_buffer[out + 4] = 0.0f;
-						out_buffer[out + 5] = 0.0f;
-						out_buffer[out + 6] = 0.0f;
-						out_buffer[out + 7] = 0.0f;
-					}
+					mix_store(out_buffer + i, _mm_load_ps(block + i), first_mix);
 				}
-				first_mix = false;
 			}
 			else
 			{
-				for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 2)
+				for (u32 out = 0, in = 0; out < out_buffer_sz; out += 16, in += 4)
 				{
-					step_volume(port);
-
-					const float left  = buf[in + 0] * m;
-					const float right = buf[in + 1] * m;
+					// Two stereo frames, placed in the front channels of two output frames
+					const __m128 frames = _mm_load_ps(block + in);
+					mix_store(out_buffer + out + 0, _mm_movelh_ps(frames, zero), first_mix);
+					mix_store(out_buffer + out + 8, _mm_movehl_ps(zero, frames), first_mix);
 
-					out_buffer[out + 0] += left;
-					out_buffer[out + 1] += right;
+					if (first_mix)
+					{
+						_mm_store_ps(out_buffer + out + 4, zero);
+						_mm_store_ps(out_buffer + out + 12, zero);
+					}
 				}
 			}
 		}
-		else if (port.num_channels == 8)
+		else
 		{
-			if (first_mix)
+			if constexpr (DownmixToStereo)
 			{
-				for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 8)
+				// value taken from https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf
+				const __m128 minus_3db = _mm_set1_ps(0.707f);
+
+				const auto downmix = [&](const float* frame)
 				{
-					step_volume(port);
-
-					const float left       = buf[in + 0] * m;
-					const float right      = buf[in + 1] * m;
-					const float center     = buf[in + 2] * m;
-					const float low_freq   = buf[in + 3] * m;
-					const float rear_left  = buf[in + 4] * m;
-					const float rear_right = buf[in + 5] * m;
-					const float side_left  = buf[in + 6] * m;
-					const float side_right = buf[in + 7] * m;
-
-					if constexpr (DownmixToStereo)
-					{
-						const float mid = center * minus_3db; /* don't mix in the lfe as per
-											 dolby specification */
-						out_buffer[out + 0] = (left + rear_left + (side_left * minus_3db) + mid) * k;
-						out_buffer[out + 1] = (right + rear_right + (side_right * minus_3db) + mid) * k;
-					}
-					else
-					{
-						out_buffer[out + 0] = left;
-						out_buffer[out + 1] = right;
-						out_buffer[out + 2] = center;
-						out_buffer[out + 3] = low_freq;
-						out_buffer[out + 4] = rear_left;
-						out_buffer[out + 5] = rear_right;
-						out_buffer[out + 6] = side_left;
-						out_buffer[out + 7] = side_right;
-					}
+					// left, right, center, low_freq | rear_left, rear_right, side_left, side_right
+					const __m128 front = _mm_load_ps(frame);
+					const __m128 rear = _mm_load_ps(frame + 4);
+
+					// don't mix in the lfe as per dolby specification
+					const __m128 mid = _mm_shuffle_ps(front, front, _MM_SHUFFLE(2, 2, 2, 2));
+					const __m128 side = _mm_movehl_ps(rear, rear);
+					return _mm_add_ps(_mm_add_ps(front, rear), _mm_mul_ps(_mm_add_ps(side, mid), minus_3db));
+				};
+
+				for (u32 out = 0, in = 0; out < out_buffer_sz; out += 4, in += 16)
+				{
+					mix_store(out_buffer + out, _mm_movelh_ps(downmix(block + in), downmix(block + in + 8)), first_mix);
 				}
-				first_mix = false;
 			}
 			else
 			{
-				for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 8)
+				for (u32 i = 0; i < out_buffer_sz; i += 4)
 				{
-					step_volume(port);
-
-					const float left       = buf[in + 0] * m;
-					const float right      = buf[in + 1] * m;
-					const float center     = buf[in + 2] * m;
-					const float low_freq   = buf[in + 3] * m;
-					const float rear_left  = buf[in + 4] * m;
-					const float rear_right = buf[in + 5] * m;
-					const float side_left  = buf[in + 6] * m;
-					const float side_right = buf[in + 7] * m;
-
-					if constexpr (DownmixToStereo)
-					{
-						const float mid = center * minus_3db;
-						out_buffer[out + 0] += (left + rear_left + (side_left * minus_3db) + mid) * k;
-						out_buffer[out + 1] += (right + rear_right + (side_right * minus_3db) + mid) * k;
-					}
-					else
-					{
-						out_buffer[out + 0] += left;
-						out_buffer[out + 1] += right;
-						out_buffer[out + 2] += center;
-						out_buffer[out + 3] += low_freq;
-						out_buffer[out + 4] += rear_left;
-						out_buffer[out + 5] += rear_right;
-						out_buffer[out + 6] += side_left;
-						out_buffer[out + 7] += side_right;
-					}
+					mix_store(out_buffer + i, _mm_load_ps(block + i), first_mix);
 				}
 			}
 		}
-		else
-		{
-			fmt::throw_exception("Unknown channel count (port=%u, channel=%d)" HERE, port.number, port.num_channels);
-		}
+
+		first_mix = false;
+
+		auto& stats = m_mix_stats[(port.num_channels == 8 ? 1 : 0) + (DownmixToStereo ? 0 : 2)];
+		stats.blocks++;
+		stats.cycles += __rdtsc() - stamp0;
 	}
 
 	// Nothing was mixed, memset out_buffer to 0
@@ -929,23 +1052,6 @@ void cell_audio_thread::mix(float *out_buffer, s32 offset)
 	{
 		std::memset(out_buffer, 0, out_buffer_sz * sizeof(float));
 	}
-	else if (g_cfg.audio.convert_to_u16)
-	{
-		// convert the data from float to u16 with clipping:
-		// 2x MULPS
-		// 2x MAXPS (optional)
-		// 2x MINPS (optional)
-		// 2x CVTPS2DQ (converts float to s32)
-		// PACKSSDW (converts s32 to s16 with signed saturation)
-
-		for (size_t i = 0; i < out_buffer_sz; i += 8)
-		{
-			const auto scale = _mm_set1_ps(0x8000);
-			_mm_store_ps(out_buffer + i / 2, _mm_castsi128_ps(_mm_packs_epi32(
-				_mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(out_buffer + i), scale)),
-				_mm_cvtps_epi32(_mm_mul_ps(_mm_load_ps(out_buffer + i + 4), scale)))));
-		}
-	}
 }
 
 void cell_audio_thread::finish_port_volume_stepping()
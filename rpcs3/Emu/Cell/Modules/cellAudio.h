@@ -5,6 +5,7 @@
 #include "Emu/Memory/vm.h"
 #include "Emu/Audio/AudioBackend.h"
 #include "Emu/Audio/AudioDumper.h"
+#include "Emu/Audio/AudioTimeStretcher.h"
 
 // Error codes
 enum CellAudioError : u32
@@ -210,8 +211,8 @@ public:
 private:
 	const bool raw_time_stretching_enabled = buffering_enabled && g_cfg.audio.enable_time_stretching && (g_cfg.audio.time_stretching_threshold > 0);
 public:
-	// We need to be able to set a dynamic frequency ratio to be able to do time stretching
-	const bool time_stretching_enabled = raw_time_stretching_enabled && backend->has_capability(AudioBackend::SET_FREQUENCY_RATIO);
+	// Time stretching is done by our own WSOLA stage, so it only depends on buffering being available
+	const bool time_stretching_enabled = raw_time_stretching_enabled;
 
 	const f32 time_stretching_threshold = g_cfg.audio.time_stretching_threshold / 100.0f; // we only apply time stretching below this buffer fill rate (adjusted for average period)
 	const f32 time_stretching_step = 0.1f; // will only reduce/increase the frequency ratio in steps of at least this value
@@ -234,6 +235,13 @@ private:
 
 	std::unique_ptr<AudioDumper> m_dump;
 
+	std::unique_ptr<AudioTimeStretcher> m_stretcher;
+	std::unique_ptr<float[]> m_stretch_buffer;
+	std::unique_ptr<float[]> m_convert_buffer;
+
+	u64 m_stretch_blocks = 0;
+	u64 m_stretch_cycles = 0;
+
 	std::unique_ptr<float[]> buffer[MAX_AUDIO_BUFFERS];
 	const float silence_buffer[u32{AUDIO_MAX_CHANNELS_COUNT} * u32{AUDIO_BUFFER_SAMPLES}] = { 0 };
 
@@ -256,6 +264,8 @@ private:
 		return has_capability(AudioBackend::PLAY_PAUSE_FLUSH | AudioBackend::IS_PLAYING) ? backend->IsPlaying() : playing;
 	}
 
+	void enqueue_block(const float* buf);
+
 public:
 	audio_ringbuffer(cell_audio_config &cfg);
 	~audio_ringbuffer();
@@ -290,11 +300,11 @@ public:
 		return enqueued_samples;
 	}
 
-	u64 get_enqueued_playtime(bool raw = false) const
+	u64 get_enqueued_playtime() const
 	{
 		AUDIT(cfg.buffering_enabled);
-		u64 sampling_rate = raw ? cfg.audio_sampling_rate : static_cast<u64>(cfg.audio_sampling_rate * frequency_ratio);
-		return enqueued_samples * 1'000'000 / sampling_rate;
+		// Enqueued samples are already stretched, so they always play at the native rate
+		return enqueued_samples * 1'000'000 / cfg.audio_sampling_rate;
 	}
 
 	bool is_playing() const
@@ -361,6 +371,15 @@ public:
 	u64 m_dynamic_period = 0;
 	f32 m_average_playtime;
 
+	// Mixer cost per port block, indexed by port layout (bit 0: 8ch port, bit 1: 8ch output)
+	struct mix_stats_t
+	{
+		u64 blocks = 0;
+		u64 cycles = 0;
+	};
+
+	std::array<mix_stats_t, 4> m_mix_stats{};
+
 	void operator()();
 
 	cell_audio_thread()
@@ -5,11 +5,16 @@
 
 #include "Emu/Cell/lv2/sys_fs.h"
 #include "Emu/Cell/lv2/sys_sync.h"
+#include "Emu/Cell/lv2/sys_ppu_thread.h"
+#include "Emu/System.h"
+#include "sysPrxForUser.h"
 #include "cellFs.h"
 
 #include "Utilities/StrUtil.h"
+#include "Utilities/cond.h"
 
 #include <mutex>
+#include <deque>
 
 LOG_CHANNEL(cellFs);
 
@@ -863,130 +868,432 @@ s32 cellFsStReadWaitCallback(u32 fd, u64 size, vm::ptr<void(s32 xfd, u64 xsize)>
 
 using fs_aio_cb_t = vm::ptr<void(vm::ptr<CellFsAio> xaio, s32 error, s32 xid, u64 size)>;
 
-struct fs_aio_thread : ppu_thread
+enum : u32
 {
-	using ppu_thread::ppu_thread;
+	fs_aio_read = 1,
+	fs_aio_write = 2,
+	fs_aio_exit = 3,
+};
+
+struct fs_aio_request
+{
+	u32 type;
+	s32 xid;
+	vm::ptr<CellFsAio> aio;
+	fs_aio_cb_t func;
+
+	// Copy of CellFsAio taken on submission
+	u32 fd;
+	u64 offset;
+	u32 buf;
+	u64 size;
+
+	// Submission time
+	u64 stamp;
+};
+
+// Host thread performing the actual I/O, requests complete out of order
+struct fs_aio_worker
+{
+	void operator()();
+};
+
+struct fs_aio_manager
+{
+	// Number of host threads processing requests
+	static constexpr u32 worker_count = 4;
+
+	// Maximum number of submitted requests not completed yet (further submissions block)
+	static constexpr u32 max_queue_depth = 64;
+
+	shared_mutex mutex;
+
+	// Signaled on submission
+	cond_variable work_cv;
+
+	// Signaled on completion
+	cond_variable free_cv;
+
+	// Signaled when cellFsAioInit has created the threads
+	cond_variable setup_cv;
+
+	// Pending requests
+	std::deque<fs_aio_request> queue;
+
+	// Number of requests being processed by workers
+	u32 in_flight = 0;
+
+	// Number of cellFsAioInit calls without cellFsAioFinish
+	u32 init_count = 0;
+
+	// Set while the first cellFsAioInit is creating the threads
+	bool setup_pending = false;
+
+	// Guest thread running callbacks
+	std::shared_ptr<named_thread<ppu_thread>> thread;
 
-	void non_task()
+	// Statistics
+	u64 stat_requests = 0;
+	u64 stat_bytes = 0;
+	u64 stat_depth_total = 0;
+	u32 stat_depth_max = 0;
+	u64 stat_latency_total = 0;
+	u64 stat_latency_max = 0;
+
+	std::unique_ptr<named_thread_group<fs_aio_worker>> workers;
+
+	~fs_aio_manager()
 	{
-		while (cmd64 cmd = cmd_wait())
-		{
-			const u32 type = cmd.arg1<u32>();
-			const s32 xid = cmd.arg2<s32>();
-			const cmd64 cmd2 = cmd_get(1);
-			const auto aio = cmd2.arg1<vm::ptr<CellFsAio>>();
-			const auto func = cmd2.arg2<fs_aio_cb_t>();
-			cmd_pop(1);
+		// Join workers before anything they use is destroyed
+		workers.reset();
 
-			s32 error = CELL_OK;
-			u64 result = 0;
+		if (stat_requests)
+		{
+			cellFs.notice("AIO: %u requests, %u bytes, average queue depth %.2f (max %u), average latency %uus (max %uus)",
+				stat_requests, stat_bytes, stat_depth_total / static_cast<double>(stat_requests), stat_depth_max, stat_latency_total / stat_requests, stat_latency_max);
+		}
+	}
 
-			const auto file = idm::get<lv2_fs_object, lv2_file>(aio->fd);
+	// Wait until a concurrent cellFsAioInit has finished (must be called with the mutex locked), returns false if stopped
+	bool wait_setup(ppu_thread& ppu, std::unique_lock<shared_mutex>& lock)
+	{
+		if (setup_pending)
+		{
+			vm::temporary_unlock(ppu);
 
-			if (!file || (type == 1 && file->flags & CELL_FS_O_WRONLY) || (type == 2 && !(file->flags & CELL_FS_O_ACCMODE)))
+			while (setup_pending)
 			{
-				error = CELL_EBADF;
+				if (ppu.is_stopped())
+				{
+					return false;
+				}
+
+				setup_cv.wait(lock, 1000);
 			}
-			else
-			{
-				std::lock_guard lock(file->mp->mutex);
+		}
 
-				const auto old_pos = file->file.pos(); file->file.seek(aio->offset);
+		return true;
+	}
 
-				result = type == 2
-					? file->op_write(aio->buf, aio->size)
-					: file->op_read(aio->buf, aio->size);
+	// Queue the callback of a finished request (must be called with the mutex locked)
+	void complete(const fs_aio_request& req, s32 error, u64 result)
+	{
+		if (!thread)
+		{
+			cellFs.error("AIO: request %d completed without the AIO thread", req.xid);
+			return;
+		}
 
-				file->file.seek(old_pos);
-			}
+		thread->cmd_list
+		({
+			{ req.type, req.xid },
+			{ req.aio, req.func },
+			{ error, 0 },
+			u64{result},
+		});
 
-			func(*this, aio, error, xid, result);
-			lv2_obj::sleep(*this);
-		}
+		thread_ctrl::notify(*thread);
 	}
 };
 
-struct fs_aio_manager
+static std::pair<s32, u64> fs_aio_execute(const fs_aio_request& req)
 {
-	std::shared_ptr<fs_aio_thread> thread;
-};
+	const auto file = idm::get<lv2_fs_object, lv2_file>(req.fd);
+
+	if (!file || (req.type == fs_aio_read && file->flags & CELL_FS_O_WRONLY) || (req.type == fs_aio_write && !(file->flags & CELL_FS_O_ACCMODE)))
+	{
+		return {CELL_EBADF, 0};
+	}
+
+	// Positional I/O doesn't need the mount point lock
+	u64 result = req.type == fs_aio_write
+		? lv2_file::op_write_at(file->file, req.offset, vm::cast(req.buf), req.size)
+		: lv2_file::op_read_at(file->file, req.offset, vm::cast(req.buf), req.size);
+
+	if (result == umax)
+	{
+		std::lock_guard lock(file->mp->mutex);
+
+		const auto old_pos = file->file.pos(); file->file.seek(req.offset);
+
+		result = req.type == fs_aio_write
+			? file->op_write(vm::cast(req.buf), req.size)
+			: file->op_read(vm::cast(req.buf), req.size);
+
+		file->file.seek(old_pos);
+	}
+	else if (req.type == fs_aio_write)
+	{
+		file->invalidate_stat();
+	}
+
+	return {CELL_OK, result};
+}
 
-s32 cellFsAioInit(vm::cptr<char> mount_point)
+void fs_aio_worker::operator()()
+{
+	const auto m = g_fxo->get<fs_aio_manager>();
+
+	while (thread_ctrl::state() != thread_state::aborting)
+	{
+		std::unique_lock lock(m->mutex);
+
+		if (m->queue.empty())
+		{
+			m->work_cv.wait(lock, 10000);
+			continue;
+		}
+
+		const fs_aio_request req = m->queue.front();
+		m->queue.pop_front();
+		m->in_flight++;
+
+		lock.unlock();
+
+		const auto [error, result] = fs_aio_execute(req);
+
+		const u64 latency = get_system_time() - req.stamp;
+
+		lock.lock();
+
+		// Queue the callback before the request stops counting as pending
+		m->complete(req, error, result);
+
+		m->in_flight--;
+		m->stat_requests++;
+		m->stat_bytes += result;
+		m->stat_latency_total += latency;
+		m->stat_latency_max = std::max(m->stat_latency_max, latency);
+
+		lock.unlock();
+
+		m->free_cv.notify_all();
+	}
+}
+
+static void fsAioEntry(ppu_thread& ppu)
+{
+	while (cmd64 cmd = ppu.cmd_wait())
+	{
+		const u32 type = cmd.arg1<u32>();
+		const s32 xid = cmd.arg2<s32>();
+
+		if (type == fs_aio_exit)
+		{
+			ppu.cmd_pop();
+			break;
+		}
+
+		const cmd64 cmd2 = ppu.cmd_get(1);
+		const auto aio = cmd2.arg1<vm::ptr<CellFsAio>>();
+		const auto func = cmd2.arg2<fs_aio_cb_t>();
+		const s32 error = ppu.cmd_get(2).arg1<s32>();
+		const u64 result = ppu.cmd_get(3).as<u64>();
+		ppu.cmd_pop(3);
+
+		func(ppu, aio, error, xid, result);
+		lv2_obj::sleep(ppu);
+	}
+
+	ppu.state += cpu_flag::exit;
+}
+
+error_code cellFsAioInit(ppu_thread& ppu, vm::cptr<char> mount_point)
 {
 	cellFs.warning("cellFsAioInit(mount_point=%s)", mount_point);
 
 	// TODO: create AIO thread (if not exists) for specified mount point
-	fmt::throw_exception("cellFsAio disabled, use LLE.");
 
+	const auto m = g_fxo->get<fs_aio_manager>();
+
+	std::unique_lock lock(m->mutex);
+
+	if (m->init_count++)
+	{
+		// Don't return before the threads exist
+		if (!m->wait_setup(ppu, lock))
+		{
+			return 0;
+		}
+
+		return CELL_OK;
+	}
+
+	m->setup_pending = true;
+	lock.unlock();
+
+	// Run callbacks on a guest thread
+	vm::var<u64> _tid;
+	vm::var<char[]> _name = vm::make_str("HLE FS AIO Thread");
+	ppu_execute<&sys_ppu_thread_create>(ppu, +_tid, 0x10000, 0, 1001, 0x4000, SYS_PPU_THREAD_CREATE_INTERRUPT, +_name);
+
+	const auto thrd = idm::get<named_thread<ppu_thread>>(static_cast<u32>(*_tid));
+
+	thrd->cmd_list
+	({
+		{ ppu_cmd::hle_call, FIND_FUNC(fsAioEntry) },
+	});
+
+	thrd->state -= cpu_flag::stop;
+	thread_ctrl::notify(*thrd);
+
+	lock.lock();
+
+	m->thread = thrd;
+
+	if (!m->workers)
+	{
+		m->workers = std::make_unique<named_thread_group<fs_aio_worker>>("FS AIO Worker ", fs_aio_manager::worker_count);
+	}
+
+	m->setup_pending = false;
+	lock.unlock();
+
+	m->setup_cv.notify_all();
 	return CELL_OK;
 }
 
-s32 cellFsAioFinish(vm::cptr<char> mount_point)
+error_code cellFsAioFinish(ppu_thread& ppu, vm::cptr<char> mount_point)
 {
 	cellFs.warning("cellFsAioFinish(mount_point=%s)", mount_point);
 
 	// TODO: delete existing AIO thread for specified mount point
 
+	const auto m = g_fxo->get<fs_aio_manager>();
+
+	std::unique_lock lock(m->mutex);
+
+	if (!m->init_count || --m->init_count)
+	{
+		return CELL_OK;
+	}
+
+	// The thread may still be being created by cellFsAioInit
+	if (!m->wait_setup(ppu, lock))
+	{
+		return 0;
+	}
+
+	vm::temporary_unlock(ppu);
+
+	// Wait for pending requests
+	while (!m->queue.empty() || m->in_flight)
+	{
+		if (ppu.is_stopped())
+		{
+			return 0;
+		}
+
+		m->free_cv.wait(lock, 1000);
+	}
+
+	const u32 tid = m->thread->id;
+
+	// Callbacks of completed requests are run before the exit command
+	m->thread->cmd_push({ fs_aio_exit, 0 });
+	thread_ctrl::notify(*m->thread);
+	m->thread.reset();
+
+	lock.unlock();
+
+	ppu_execute<&sys_interrupt_thread_disestablish>(ppu, tid);
+
 	return CELL_OK;
 }
 
 atomic_t<s32> g_fs_aio_id;
 
-s32 cellFsAioRead(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+static error_code fs_aio_submit(ppu_thread& ppu, u32 type, vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
 {
-	cellFs.warning("cellFsAioRead(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
-
 	// TODO: detect mount point and send AIO request to the AIO thread of this mount point
 
 	const auto m = g_fxo->get<fs_aio_manager>();
 
-	if (!m)
+	std::unique_lock lock(m->mutex);
+
+	if (!m->wait_setup(ppu, lock))
+	{
+		return 0;
+	}
+
+	if (!m->thread)
 	{
 		return CELL_ENXIO;
 	}
 
+	// Bounded queue: wait until a request completes
+	if (m->queue.size() + m->in_flight >= fs_aio_manager::max_queue_depth)
+	{
+		vm::temporary_unlock(ppu);
+
+		while (m->queue.size() + m->in_flight >= fs_aio_manager::max_queue_depth)
+		{
+			if (ppu.is_stopped())
+			{
+				return 0;
+			}
+
+			m->free_cv.wait(lock, 1000);
+		}
+	}
+
 	const s32 xid = (*id = ++g_fs_aio_id);
 
-	m->thread->cmd_list
-	({
-		{ 1, xid },
-		{ aio, func },
-	});
+	m->queue.push_back(fs_aio_request{type, xid, aio, func, aio->fd, aio->offset, aio->buf.addr(), aio->size, get_system_time()});
+
+	const u32 depth = ::size32(m->queue) + m->in_flight;
+	m->stat_depth_total += depth;
+	m->stat_depth_max = std::max(m->stat_depth_max, depth);
+
+	lock.unlock();
+
+	m->work_cv.notify_one();
 
 	return CELL_OK;
 }
 
-s32 cellFsAioWrite(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+error_code cellFsAioRead(ppu_thread& ppu, vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+{
+	cellFs.warning("cellFsAioRead(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+
+	return fs_aio_submit(ppu, fs_aio_read, aio, id, func);
+}
+
+error_code cellFsAioWrite(ppu_thread& ppu, vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
 {
 	cellFs.warning("cellFsAioWrite(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
 
-	// TODO: detect mount point and send AIO request to the AIO thread of this mount point
+	return fs_aio_submit(ppu, fs_aio_write, aio, id, func);
+}
 
-	const auto m = g_fxo->get<fs_aio_manager>();
+error_code cellFsAioCancel(s32 id)
+{
+	cellFs.warning("cellFsAioCancel(id=%d)", id);
 
-	if (!m)
-	{
-		return CELL_ENXIO;
-	}
+	const auto m = g_fxo->get<fs_aio_manager>();
 
-	const s32 xid = (*id = ++g_fs_aio_id);
+	std::unique_lock lock(m->mutex);
 
-	m->thread->cmd_list
-	({
-		{ 2, xid },
-		{ aio, func },
+	// Only requests not picked up by a worker can be cancelled
+	const auto found = std::find_if(m->queue.begin(), m->queue.end(), [&](const fs_aio_request& req)
+	{
+		return req.xid == id;
 	});
 
-	return CELL_OK;
-}
+	if (found == m->queue.end())
+	{
+		return CELL_EINVAL;
+	}
 
-s32 cellFsAioCancel(s32 id)
-{
-	cellFs.todo("cellFsAioCancel(id=%d) -> CELL_EINVAL", id);
+	// Cancelled requests return CELL_ECANCELED through their own callbacks
+	m->complete(*found, CELL_ECANCELED, 0);
+	m->queue.erase(found);
 
-	// TODO: cancelled requests return CELL_ECANCELED through their own callbacks
+	lock.unlock();
 
-	return CELL_EINVAL;
+	m->free_cv.notify_all();
+
+	return CELL_OK;
 }
 
 s32 cellFsArcadeHddSerialNumber()
@@ -1017,6 +1324,7 @@ DECLARE(ppu_module_manager::cellFs)("sys_fs", []()
 	REG_FUNC(sys_fs, cellFsAioInit);
 	REG_FUNC(sys_fs, cellFsAioRead);
 	REG_FUNC(sys_fs, cellFsAioWrite);
+	REG_FUNC(sys_fs, fsAioEntry).flag(MFF_HIDDEN);
 	REG_FUNC(sys_fs, cellFsAllocateFileAreaByFdWithInitialData);
 	REG_FUNC(sys_fs, cellFsAllocateFileAreaByFdWithoutZeroFill);
 	REG_FUNC(sys_fs, cellFsAllocateFileAreaWithInitialData);
@@ -652,7 +652,9 @@ error_code cellGameDataCheckCreate2(ppu_thread& ppu, u32 version, vm::cptr<char>
 				psf::assign(sfo, fmt::format("TITLE_%02d", i), psf::string(CELL_GAME_SYSP_TITLE_SIZE, setParam->titleLang[i]));
 			}
 
-			psf::save_object(fs::file(vfs::get(dir + "/PARAM.SFO"), fs::rewrite), sfo);
+			const std::string sfo_path = vfs::get(dir + "/PARAM.SFO");
+			psf::save_object(fs::file(sfo_path, fs::rewrite), sfo);
+			vfs::host::invalidate(sfo_path);
 		}
 
 		return CELL_OK;
@@ -1,4 +1,5 @@
 ﻿#include "stdafx.h"
+#include "Emu/System.h"
 #include "Emu/IdManager.h"
 #include "Emu/Cell/PPUModule.h"
 #include "Emu/Cell/lv2/sys_process.h"
@@ -167,6 +168,11 @@ error_code cellPadGetData(u32 port_no, vm::ptr<CellPadData> data)
 		return CELL_OK;
 	}
 
+	if (const u64 input_timestamp = pad->m_input_timestamp.exchange(0))
+	{
+		handler->RecordInputLatency(get_system_time() - input_timestamp);
+	}
+
 	bool btnChanged = false;
 
 	if (rinfo.ignore_input)
@@ -223,6 +223,7 @@ static error_code select_and_delete(ppu_thread& ppu)
 			// Remove directory
 			const std::string path = base_dir + save_entries[selected].escaped;
 			fs::remove_all(path);
+			vfs::host::invalidate(path, true);
 
 			// Remove entry from the list and reset the selection
 			save_entries.erase(save_entries.cbegin() + selected);
@@ -15,6 +15,7 @@ enum class ppu_attr : u32
 	known_size,
 	no_return,
 	no_size,
+	inline_leaf,
 
 	__bitset_enum_max
 };
@@ -4,6 +4,7 @@
 #include "Utilities/VirtualMemory.h"
 #include "Utilities/bin_patch.h"
 #include "Utilities/StrUtil.h"
+#include "Utilities/sysinfo.h"
 #include "Crypto/sha1.h"
 #include "Crypto/unself.h"
 #include "Loader/ELF.h"
@@ -1402,9 +1403,35 @@ void ppu_load_exec(const ppu_exec_object& elf)
 				"\nVisit https://rpcs3.net/ for Quickstart Guide and more information.");
 		}
 
-		for (const auto& name : load_libs)
+		// Decrypt and parse all libraries ahead of time, this is independent work
+		const std::vector<std::string> lib_names(load_libs.begin(), load_libs.end());
+		std::vector<ppu_prx_object> lib_objs(lib_names.size());
+
+		atomic_t<u32> lib_index = 0;
+
+		auto decrypt_libs = [&]()
+		{
+			for (u32 i = lib_index++; i < lib_names.size(); i = lib_index++)
+			{
+				lib_objs[i].open(decrypt_self(fs::file(lle_dir + lib_names[i])));
+			}
+		};
+
+		if (const u32 thread_count = std::min<u32>(utils::get_thread_count(), ::size32(lib_names)); thread_count > 1)
+		{
+			named_thread_group workers("PRX Decrypter ", thread_count, decrypt_libs);
+			workers.join();
+		}
+		else
+		{
+			decrypt_libs();
+		}
+
+		// Loading and linking remain serial to keep memory layout and linkage order deterministic
+		for (std::size_t i = 0; i < lib_names.size(); i++)
 		{
-			const ppu_prx_object obj = decrypt_self(fs::file(lle_dir + name));
+			const std::string& name = lib_names[i];
+			const ppu_prx_object& obj = lib_objs[i];
 
 			if (obj == elf_error::ok)
 			{
@@ -45,7 +45,9 @@
 #include "llvm/Analysis/Lint.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Scalar/GVN.h"
 #include "llvm/Transforms/IPO.h"
+#include "llvm/Transforms/IPO/AlwaysInliner.h"
 #include "llvm/Transforms/Vectorize.h"
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -104,6 +106,79 @@ static T& ppu_ref(u32 addr)
 	return *reinterpret_cast<T*>(vm::g_exec_addr + u64{addr} * 2);
 }
 
+// Comparison fused with the following conditional branch (fast interpreter)
+template <bool(*Cmp)(ppu_thread&, ppu_opcode_t)>
+static bool ppu_fused_cmp_bc(ppu_thread& ppu, ppu_opcode_t op)
+{
+	Cmp(ppu, op);
+
+	// Branch opcode is taken from the executable cache, validated by ppu_fuse (CTR unused, no LK)
+	const ppu_opcode_t br{static_cast<u32>(ppu_ref(ppu.cia + 4) >> 32)};
+
+	if ((br.bo & 0x10) || !!ppu.cr[br.bi] == !!(br.bo & 0x08))
+	{
+		ppu.cia = (br.aa ? 0 : ppu.cia + 4) + br.bt14;
+		return false;
+	}
+
+	// Fall through to the branch entry which is not taken either, keeps the caller's batch going
+	return true;
+}
+
+static bool ppu_is_fused(u32 func)
+{
+	return func == ::narrow<u32>(reinterpret_cast<std::uintptr_t>(&ppu_fused_cmp_bc<&ppu_interpreter::CMPI>)) ||
+		func == ::narrow<u32>(reinterpret_cast<std::uintptr_t>(&ppu_fused_cmp_bc<&ppu_interpreter::CMPLI>)) ||
+		func == ::narrow<u32>(reinterpret_cast<std::uintptr_t>(&ppu_fused_cmp_bc<&ppu_interpreter::CMP>)) ||
+		func == ::narrow<u32>(reinterpret_cast<std::uintptr_t>(&ppu_fused_cmp_bc<&ppu_interpreter::CMPL>));
+}
+
+// Get fused handler for the instruction pair at addr, or nullptr
+static decltype(&ppu_interpreter::UNK) ppu_fuse(u32 addr, ppu_opcode_t op)
+{
+	if (g_cfg.core.ppu_decoder != ppu_decoder_type::fast || g_cfg.core.ppu_debug)
+	{
+		return nullptr;
+	}
+
+	decltype(&ppu_interpreter::UNK) result{};
+
+	switch (op.main)
+	{
+	case 0x0a: result = &ppu_fused_cmp_bc<&ppu_interpreter::CMPLI>; break;
+	case 0x0b: result = &ppu_fused_cmp_bc<&ppu_interpreter::CMPI>; break;
+	case 0x1f:
+	{
+		if ((op.opcode & 0x7fe) == 0x000) result = &ppu_fused_cmp_bc<&ppu_interpreter::CMP>;
+		if ((op.opcode & 0x7fe) == 0x040) result = &ppu_fused_cmp_bc<&ppu_interpreter::CMPL>;
+		break;
+	}
+	default: break;
+	}
+
+	if (!result || !vm::check_addr(addr + 4, 4, vm::page_executable))
+	{
+		return nullptr;
+	}
+
+	// The next instruction must be up to date in the executable cache and must not be a breakpoint
+	const u64 next = ppu_ref(addr + 4);
+	const ppu_opcode_t br{vm::read32(addr + 4)};
+
+	if (static_cast<u32>(next >> 32) != br.opcode || static_cast<u32>(next) == ::narrow<u32>(reinterpret_cast<std::uintptr_t>(&ppu_break)))
+	{
+		return nullptr;
+	}
+
+	// BC without CTR decrement and without LK
+	if (br.main != 0x10 || br.lk || !(br.bo & 0x04))
+	{
+		return nullptr;
+	}
+
+	return result;
+}
+
 // Get interpreter cache value
 static u64 ppu_cache(u32 addr)
 {
@@ -114,9 +189,24 @@ static u64 ppu_cache(u32 addr)
 		(fmt::throw_exception("Invalid PPU decoder"), nullptr));
 
 	const u32 value = vm::read32(addr);
+
+	if (const auto fused = ppu_fuse(addr, {value}))
+	{
+		return u64{value} << 32 | ::narrow<u32>(reinterpret_cast<std::uintptr_t>(fused));
+	}
+
 	return u64{value} << 32 | ::narrow<u32>(reinterpret_cast<std::uintptr_t>(table[ppu_decode(value)]));
 }
 
+// Update the preceding instruction if it was fused with the one at addr
+static void ppu_unfuse(u32 addr)
+{
+	if (vm::check_addr(addr - 4, 4, vm::page_executable) && ppu_is_fused(ppu_ref<u32>(addr - 4)))
+	{
+		ppu_ref(addr - 4) = ppu_cache(addr - 4);
+	}
+}
+
 static bool ppu_fallback(ppu_thread& ppu, ppu_opcode_t op)
 {
 	if (g_cfg.core.ppu_debug)
@@ -295,6 +385,8 @@ extern void ppu_breakpoint(u32 addr, bool isAdding)
 		// Remove breakpoint
 		ppu_ref(addr) = ppu_cache(addr);
 	}
+
+	ppu_unfuse(addr);
 }
 
 //sets breakpoint, does nothing if there is a breakpoint there already
@@ -310,6 +402,7 @@ extern void ppu_set_breakpoint(u32 addr)
 	if (ppu_ref<u32>(addr) != _break)
 	{
 		ppu_ref<u32>(addr) = _break;
+		ppu_unfuse(addr);
 	}
 }
 
@@ -326,6 +419,7 @@ extern void ppu_remove_breakpoint(u32 addr)
 	if (ppu_ref<u32>(addr) == _break)
 	{
 		ppu_ref(addr) = ppu_cache(addr);
+		ppu_unfuse(addr);
 	}
 }
 
@@ -352,6 +446,7 @@ extern bool ppu_patch(u32 addr, u32 value)
 		ppu_ref(addr) = ppu_cache(addr);
 	}
 
+	ppu_unfuse(addr);
 	return true;
 }
 
@@ -1467,40 +1562,39 @@ extern void ppu_initialize(const ppu_module& info)
 	// Info to load to main JIT instance (true - compiled)
 	std::vector<std::pair<std::string, bool>> link_workload;
 
+	// First function of each module part in link_workload
+	std::vector<std::size_t> link_fstart;
+
+	// Loaded objects for link_workload (each buffer is released by jit_compiler::add)
+	std::vector<std::unique_ptr<llvm::MemoryBuffer>> link_objects;
+
 	// Sync variable to acquire workloads
 	atomic_t<u32> work_cv = 0;
 
-	while (jit_mod.vars.empty() && fpos < info.funcs.size())
+	// Build module part starting at the given function, advances the position past the last function in the part
+	const auto make_part = [&](std::size_t& pos)
 	{
-		// Initialize compiler instance
-		if (!jit && get_current_cpu_thread())
-		{
-			jit = std::make_shared<jit_compiler>(s_link_table, g_cfg.core.llvm_cpu);
-		}
-
-		// First function in current module part
-		const auto fstart = fpos;
-
 		// Copy module information (TODO: optimize)
 		ppu_module part;
 		part.copy_part(info);
 		part.funcs.reserve(16000);
 
-		// Unique suffix for each module part
-		const u32 suffix = info.funcs.at(fstart).addr - reloc;
-
 		// Overall block size in bytes
 		std::size_t bsize = 0;
 
-		while (fpos < info.funcs.size())
+		while (pos < info.funcs.size())
 		{
-			auto& func = info.funcs[fpos];
+			auto& func = info.funcs[pos];
 
 			if (bsize + func.size > 100 * 1024 && bsize)
 			{
 				break;
 			}
 
+			// Small single-block function without calls which returns with BLR
+			const bool is_leaf = g_cfg.core.llvm_ppu_inline && func.calls.empty() && func.blocks.size() == 1 && func.size && func.size <= 256 &&
+				!(func.attr & ppu_attr::no_return) && vm::read32(func.addr + func.size - 4) == ppu_instructions::BLR();
+
 			for (auto&& block : func.blocks)
 			{
 				bsize += block.second;
@@ -1511,12 +1605,89 @@ extern void ppu_initialize(const ppu_module& info)
 				entry.size = block.second;
 				entry.toc  = func.toc;
 				fmt::append(entry.name, "__0x%x", block.first - reloc);
+
+				if (is_leaf)
+				{
+					entry.attr += ppu_attr::inline_leaf;
+				}
+
 				part.funcs.emplace_back(std::move(entry));
 			}
 
-			fpos++;
+			pos++;
+		}
+
+		return part;
+	};
+
+	struct thread_index_allocator
+	{
+		atomic_t<u64> index = 0;
+	};
+
+	// Load objects from the cache in parallel (the main JIT instance is not thread-safe, so they are linked afterwards)
+	const auto load_objects = [&](bool compiled)
+	{
+		u32 thread_count = Emu.GetMaxThreads();
+
+		if (link_workload.size() < thread_count)
+		{
+			thread_count = ::size32(link_workload);
+		}
+
+		atomic_t<u32> load_cv = 0;
+
+		named_thread_group threads(fmt::format("PPUL.%u.", ++g_fxo->get<thread_index_allocator>()->index), thread_count, [&]()
+		{
+			for (u32 i = load_cv++; i < link_workload.size(); i = load_cv++)
+			{
+				if (link_workload[i].second != compiled || Emu.IsStopped())
+				{
+					continue;
+				}
+
+				auto object = jit_compiler::load(cache_path + link_workload[i].first);
+
+				if (!compiled && !object)
+				{
+					// Missing or damaged, needs compilation
+					link_workload[i].second = true;
+				}
+
+				// Without the main JIT instance only the existence matters
+				if (jit)
+				{
+					link_objects[i] = std::move(object);
+				}
+			}
+		});
+
+		threads.join();
+	};
+
+	// Warm boot statistics
+	const u64 time_start = get_system_time();
+	u64 time_check = 0;
+	u64 time_compile = 0;
+	u64 time_load = 0;
+	u64 time_link = 0;
+
+	while (jit_mod.vars.empty() && fpos < info.funcs.size())
+	{
+		// Initialize compiler instance
+		if (!jit && get_current_cpu_thread())
+		{
+			jit = std::make_shared<jit_compiler>(s_link_table, g_cfg.core.llvm_cpu);
 		}
 
+		// First function in current module part
+		const auto fstart = fpos;
+
+		ppu_module part = make_part(fpos);
+
+		// Unique suffix for each module part
+		const u32 suffix = info.funcs.at(fstart).addr - reloc;
+
 		// Compute module hash to generate (hopefully) unique object name
 		std::string obj_name;
 		{
@@ -1593,6 +1764,7 @@ extern void ppu_initialize(const ppu_module& info)
 				non_win32,
 				accurate_fma,
 				accurate_ppu_vector_nan,
+				inline_leaf,
 
 				__bitset_enum_max
 			};
@@ -1610,6 +1782,10 @@ extern void ppu_initialize(const ppu_module& info)
 			{
 				settings += ppu_settings::accurate_ppu_vector_nan;
 			}
+			if (g_cfg.core.llvm_ppu_inline)
+			{
+				settings += ppu_settings::inline_leaf;
+			}
 
 			// Write version, hash, CPU, settings
 			fmt::append(obj_name, "v3-tane-%s-%s-%s.obj", fmt::base57(output, 16), fmt::base57(settings), jit_compiler::cpu(g_cfg.core.llvm_cpu));
@@ -1629,25 +1805,32 @@ extern void ppu_initialize(const ppu_module& info)
 			globals.emplace_back(fmt::format("__seg%u_%x", i, suffix), info.segs[i].addr);
 		}
 
-		link_workload.emplace_back(obj_name, false);
+		link_workload.emplace_back(std::move(obj_name), false);
+		link_fstart.emplace_back(fstart);
+	}
 
-		// Check object file
-		if (jit_compiler::check(cache_path + obj_name))
+	// Check object files (they are checked in parallel because this involves decompressing all of them)
+	link_objects.resize(link_workload.size());
+	load_objects(false);
+	time_check = get_system_time();
+
+	for (std::size_t i = 0; i < link_workload.size(); i++)
+	{
+		const auto& [obj_name, is_compiled] = link_workload[i];
+
+		if (!is_compiled)
 		{
 			if (!jit)
 			{
 				ppu_log.success("LLVM: Module exists: %s", obj_name);
-				continue;
 			}
 
 			continue;
 		}
 
-		// Adjust information (is_compiled)
-		link_workload.back().second = true;
-
 		// Fill workload list for compilation
-		workload.emplace_back(std::move(obj_name), std::move(part));
+		std::size_t pos = link_fstart[i];
+		workload.emplace_back(obj_name, make_part(pos));
 
 		// Update progress dialog
 		g_progr_ptotal++;
@@ -1662,11 +1845,6 @@ extern void ppu_initialize(const ppu_module& info)
 			thread_count = ::size32(workload);
 		}
 
-		struct thread_index_allocator
-		{
-			atomic_t<u64> index = 0;
-		};
-
 		named_thread_group threads(fmt::format("PPUW.%u.", ++g_fxo->get<thread_index_allocator>()->index), thread_count, [&]()
 		{
 			// Set low priority
@@ -1685,7 +1863,7 @@ extern void ppu_initialize(const ppu_module& info)
 					ppu_log.warning("LLVM: Compiling module %s%s", cache_path, obj_name);
 
 					// Use another JIT instance
-					jit_compiler jit2({}, g_cfg.core.llvm_cpu, 0x1);
+					jit_compiler jit2({}, g_cfg.core.llvm_cpu, g_cfg.core.llvm_compress_cache ? 0x1 : 0x5);
 					ppu_initialize2(jit2, part, cache_path, obj_name);
 
 					ppu_log.success("LLVM: Compiled module %s", obj_name);
@@ -1702,22 +1880,42 @@ extern void ppu_initialize(const ppu_module& info)
 			return;
 		}
 
+		time_compile = get_system_time();
+
+		// Load newly compiled objects
+		if (!workload.empty())
+		{
+			load_objects(true);
+		}
+
+		time_load = get_system_time();
+
 		std::lock_guard lock(jmutex);
 
-		for (auto [obj_name, is_compiled] : link_workload)
+		for (std::size_t i = 0; i < link_workload.size(); i++)
 		{
+			const auto& [obj_name, is_compiled] = link_workload[i];
+
 			if (Emu.IsStopped())
 			{
 				break;
 			}
 
-			jit->add(cache_path + obj_name);
+			if (!link_objects[i])
+			{
+				ppu_log.error("LLVM: Failed to load module %s", obj_name);
+				continue;
+			}
+
+			jit->add(std::move(link_objects[i]));
 
 			if (!is_compiled)
 			{
 				ppu_log.success("LLVM: Loaded module %s", obj_name);
 			}
 		}
+
+		time_link = get_system_time();
 	}
 
 	if (Emu.IsStopped() || !get_current_cpu_thread())
@@ -1731,6 +1929,10 @@ extern void ppu_initialize(const ppu_module& info)
 		std::lock_guard lock(jmutex);
 		jit->fin();
 
+		ppu_log.notice("LLVM: %u module parts (%u compiled): check %.3fs, compile %.3fs, load %.3fs, link %.3fs, finalize %.3fs",
+			link_workload.size(), workload.size(), (time_check - time_start) / 1000000., (time_compile - time_check) / 1000000.,
+			(time_load - time_compile) / 1000000., (time_link - time_load) / 1000000., (get_system_time() - time_link) / 1000000.);
+
 		// Get and install function addresses
 		for (const auto& func : info.funcs)
 		{
@@ -1823,6 +2025,11 @@ static void ppu_initialize2(jit_compiler& jit, const ppu_module& module_part, co
 		{
 			const auto f = cast<Function>(_module->getOrInsertFunction(func.name, _func).getCallee());
 			f->addAttribute(1, Attribute::NoAlias);
+
+			if (func.attr & ppu_attr::inline_leaf)
+			{
+				f->addFnAttr(Attribute::AlwaysInline);
+			}
 		}
 	}
 
@@ -1882,6 +2089,81 @@ static void ppu_initialize2(jit_compiler& jit, const ppu_module& module_part, co
 		//mpm.add(createDeadInstEliminationPass());
 		//mpm.run(*module);
 
+		if (g_cfg.core.llvm_ppu_inline)
+		{
+			// Inline leaf functions into their callers (they are still emitted for other callers)
+			mpm.add(createAlwaysInlinerLegacyPass());
+			mpm.run(*_module);
+
+			// Forward registers stored before the call to the inlined code (notably LR)
+			legacy::FunctionPassManager ipm(_module.get());
+			ipm.add(createGVNPass());
+			ipm.add(createDeadStoreEliminationPass());
+
+			GlobalVariable* cptr = nullptr;
+
+			for (auto& gv : _module->globals())
+			{
+				if (gv.getName().startswith("__cptr"))
+				{
+					cptr = &gv;
+				}
+			}
+
+			std::size_t direct_calls = 0;
+
+			for (auto& f : *_module)
+			{
+				if (f.isDeclaration())
+				{
+					continue;
+				}
+
+				ipm.run(f);
+
+				// Replace calls through the executable cache with a constant position by direct calls (see PPUTranslator::CallFunction)
+				for (auto& bb : f)
+				{
+					for (auto it = bb.begin(); it != bb.end();)
+					{
+						const auto ci = dyn_cast<CallInst>(&*it++);
+						const auto itp = ci ? dyn_cast<IntToPtrInst>(ci->getCalledOperand()) : nullptr;
+						const auto ld = itp ? dyn_cast<LoadInst>(itp->getOperand(0)) : nullptr;
+						const auto gep = ld ? dyn_cast<GetElementPtrInst>(ld->getPointerOperand()) : nullptr;
+
+						if (!gep || gep->getNumIndices() != 2 || !isa<ConstantInt>(gep->getOperand(2)))
+						{
+							continue;
+						}
+
+						const auto base = dyn_cast<LoadInst>(gep->getPointerOperand());
+
+						if (!base || !cptr || base->getPointerOperand() != cptr)
+						{
+							continue;
+						}
+
+						// Position is (addr / 4 * 2)
+						const u64 addr = cast<ConstantInt>(gep->getOperand(2))->getZExtValue() * 2;
+						const auto target = _module->getFunction(fmt::format("__0x%x", addr));
+
+						if (!target || target->isDeclaration())
+						{
+							continue;
+						}
+
+						const auto call = CallInst::Create(target, {ci->getArgOperand(0)}, "", ci);
+						call->setTailCallKind(ci->getTailCallKind());
+						ci->replaceAllUsesWith(call);
+						ci->eraseFromParent();
+						direct_calls++;
+					}
+				}
+			}
+
+			ppu_log.notice("LLVM: %zu direct calls resolved after inlining", direct_calls);
+		}
+
 		std::string result;
 		raw_string_ostream out(result);
 
@@ -61,6 +61,9 @@ public:
 	static const u32 id_step = 1;
 	static const u32 id_count = 2048;
 
+	// Guest threads are often short-lived, reuse host threads
+	static constexpr bool thread_pooled = true;
+
 	virtual std::string dump_all() const override;
 	virtual std::string dump_regs() const override;
 	virtual std::string dump_callstack() const override;
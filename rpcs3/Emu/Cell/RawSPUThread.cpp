@@ -158,6 +158,12 @@ bool spu_thread::write_reg(const u32 addr, const u32 value)
 {
 	const u32 offset = addr - RAW_SPU_BASE_ADDR - index * RAW_SPU_OFFSET - RAW_SPU_PROB_OFFSET;
 
+	if (ls_tracked)
+	{
+		// RawSPU LS is mapped in PPU address space: assume it was modified before signalling the SPU
+		ls_write_notify(0, 0x40000);
+	}
+
 	switch (offset)
 	{
 	case MFC_LSA_offs:
@@ -251,6 +251,43 @@ spu_function_t spu_recompiler::compile(spu_program&& _func)
 		}
 	};
 
+	// Skip verification if LS pages covered by the function weren't modified since last check
+	const bool ls_track = ls_tracking() && m_size > 8;
+	const u32 ls_slot = (m_hash_start >> 20) % 1024;
+	Label label_verified = c->newLabel();
+
+	// Get verification tag in rax and sum of page generations in qw0
+	auto get_ls_gen = [&]()
+	{
+		const u32 npages = std::min<u32>(((end - start - 1) >> 12) + 2, 64);
+
+		c->lea(qw1->r32(), x86::dword_ptr(*pc0, start - m_base));
+		c->and_(qw1->r32(), 0x3fffc);
+		c->shr(qw1->r32(), 12);
+		c->xor_(qw0->r32(), qw0->r32());
+
+		for (u32 i = 0; i < npages; i++)
+		{
+			c->lea(x86::eax, x86::dword_ptr(*qw1, i));
+			c->and_(x86::eax, 63);
+			c->add(*qw0, x86::qword_ptr(*cpu, x86::rax, 3, ::offset32(&spu_thread::ls_gen)));
+		}
+
+		c->mov(x86::rax, m_hash_start & ~u64{0x3ffff});
+		c->or_(x86::rax, *pc0);
+	};
+
+	if (ls_track)
+	{
+		Label label_check = c->newLabel();
+		get_ls_gen();
+		c->cmp(x86::rax, SPU_OFF_64(ls_verify_tag, ls_slot));
+		c->jne(label_check);
+		c->cmp(*qw0, SPU_OFF_64(ls_verify_gen, ls_slot));
+		c->je(label_verified);
+		c->bind(label_check);
+	}
+
 	if (!g_cfg.core.spu_verification)
 	{
 		// Disable check (unsafe)
@@ -754,6 +791,26 @@ spu_function_t spu_recompiler::compile(spu_program&& _func)
 		}
 	}
 
+	if (ls_track)
+	{
+		// Remember successful verification
+		Label label_next = c->newLabel();
+		get_ls_gen();
+		c->mov(SPU_OFF_64(ls_verify_tag, ls_slot), x86::rax);
+		c->mov(SPU_OFF_64(ls_verify_gen, ls_slot), *qw0);
+		c->inc(SPU_OFF_64(block_recheck));
+		c->jmp(label_next);
+
+		c->bind(label_verified);
+
+		if (utils::has_avx())
+		{
+			c->vzeroupper();
+		}
+
+		c->bind(label_next);
+	}
+
 	// Acknowledge success and add statistics
 	c->add(SPU_OFF_64(block_counter), ::size32(words) / (words_align / 4));
 
@@ -2739,6 +2796,13 @@ void spu_recompiler::STQX(spu_opcode_t op)
 		c->mov(asmjit::x86::qword_ptr(*ls, addr->r64(), 0, 0), *qw1);
 		c->mov(asmjit::x86::qword_ptr(*ls, addr->r64(), 0, 8), *qw0);
 	}
+
+	if (ls_tracking())
+	{
+		// Increment generation of the modified page
+		c->shr(*addr, 12);
+		c->inc(asmjit::x86::qword_ptr(*cpu, addr->r64(), 3, ::offset32(&spu_thread::ls_gen)));
+	}
 }
 
 void spu_recompiler::BI(spu_opcode_t op)
@@ -4193,6 +4257,11 @@ void spu_recompiler::STQA(spu_opcode_t op)
 		c->mov(asmjit::x86::qword_ptr(*ls, spu_ls_target(0, op.i16) + 0), *qw1);
 		c->mov(asmjit::x86::qword_ptr(*ls, spu_ls_target(0, op.i16) + 8), *qw0);
 	}
+
+	if (ls_tracking())
+	{
+		c->inc(SPU_OFF_64(ls_gen, spu_ls_target(0, op.i16) >> 12));
+	}
 }
 
 void spu_recompiler::BRNZ(spu_opcode_t op)
@@ -4278,6 +4347,13 @@ void spu_recompiler::STQR(spu_opcode_t op)
 		c->mov(asmjit::x86::qword_ptr(*ls, addr->r64(), 0, 0), *qw1);
 		c->mov(asmjit::x86::qword_ptr(*ls, addr->r64(), 0, 8), *qw0);
 	}
+
+	if (ls_tracking())
+	{
+		// Increment generation of the modified page
+		c->shr(*addr, 12);
+		c->inc(asmjit::x86::qword_ptr(*cpu, addr->r64(), 3, ::offset32(&spu_thread::ls_gen)));
+	}
 }
 
 void spu_recompiler::BRA(spu_opcode_t op)
@@ -4511,6 +4587,13 @@ void spu_recompiler::STQD(spu_opcode_t op)
 		c->mov(asmjit::x86::qword_ptr(*ls, addr->r64(), 0, 0), *qw1);
 		c->mov(asmjit::x86::qword_ptr(*ls, addr->r64(), 0, 8), *qw0);
 	}
+
+	if (ls_tracking())
+	{
+		// Increment generation of the modified page
+		c->shr(*addr, 12);
+		c->inc(asmjit::x86::qword_ptr(*cpu, addr->r64(), 3, ::offset32(&spu_thread::ls_gen)));
+	}
 }
 
 void spu_recompiler::LQD(spu_opcode_t op)
@@ -490,7 +490,14 @@ bool spu_interpreter::STOPD(spu_thread& spu, spu_opcode_t op)
 
 bool spu_interpreter::STQX(spu_thread& spu, spu_opcode_t op)
 {
-	spu._ref<v128>((spu.gpr[op.ra]._u32[3] + spu.gpr[op.rb]._u32[3]) & 0x3fff0) = spu.gpr[op.rt];
+	const u32 lsa = (spu.gpr[op.ra]._u32[3] + spu.gpr[op.rb]._u32[3]) & 0x3fff0;
+	spu._ref<v128>(lsa) = spu.gpr[op.rt];
+
+	if (spu.ls_tracked)
+	{
+		spu.ls_gen[lsa >> 12]++;
+	}
+
 	return true;
 }
 
@@ -1368,7 +1375,14 @@ bool spu_interpreter::BRZ(spu_thread& spu, spu_opcode_t op)
 
 bool spu_interpreter::STQA(spu_thread& spu, spu_opcode_t op)
 {
-	spu._ref<v128>(spu_ls_target(0, op.i16)) = spu.gpr[op.rt];
+	const u32 lsa = spu_ls_target(0, op.i16);
+	spu._ref<v128>(lsa) = spu.gpr[op.rt];
+
+	if (spu.ls_tracked)
+	{
+		spu.ls_gen[lsa >> 12]++;
+	}
+
 	return true;
 }
 
@@ -1404,7 +1418,14 @@ bool spu_interpreter::BRHNZ(spu_thread& spu, spu_opcode_t op)
 
 bool spu_interpreter::STQR(spu_thread& spu, spu_opcode_t op)
 {
-	spu._ref<v128>(spu_ls_target(spu.pc, op.i16)) = spu.gpr[op.rt];
+	const u32 lsa = spu_ls_target(spu.pc, op.i16);
+	spu._ref<v128>(lsa) = spu.gpr[op.rt];
+
+	if (spu.ls_tracked)
+	{
+		spu.ls_gen[lsa >> 12]++;
+	}
+
 	return true;
 }
 
@@ -1544,7 +1565,14 @@ bool spu_interpreter::AHI(spu_thread& spu, spu_opcode_t op)
 
 bool spu_interpreter::STQD(spu_thread& spu, spu_opcode_t op)
 {
-	spu._ref<v128>((spu.gpr[op.ra]._s32[3] + (op.si10 * 16)) & 0x3fff0) = spu.gpr[op.rt];
+	const u32 lsa = (spu.gpr[op.ra]._s32[3] + (op.si10 * 16)) & 0x3fff0;
+	spu._ref<v128>(lsa) = spu.gpr[op.rt];
+
+	if (spu.ls_tracked)
+	{
+		spu.ls_gen[lsa >> 12]++;
+	}
+
 	return true;
 }
 
@@ -695,8 +695,8 @@ spu_function_t spu_runtime::rebuild_ubertrampoline(u32 id_inst)
 
 	if (size0 != 1)
 	{
-		// Allocate some writable executable memory
-		u8* const wxptr = jit_runtime::alloc(size0 * 22 + 14, 16);
+		// Allocate some writable executable memory (reclaimed after being replaced)
+		u8* const wxptr = jit_runtime::alloc_reclaimable(size0 * 22 + 14);
 
 		if (!wxptr)
 		{
@@ -968,6 +968,12 @@ spu_function_t spu_runtime::rebuild_ubertrampoline(u32 id_inst)
 
 	if (auto _old = stuff_it->trampoline.compare_and_swap(nullptr, result))
 	{
+		if (size0 != 1)
+		{
+			// Another thread installed its trampoline first, nothing could have jumped to ours
+			jit_runtime::retire(reinterpret_cast<const void*>(result));
+		}
+
 		return _old;
 	}
 
@@ -1000,9 +1006,45 @@ spu_function_t spu_runtime::rebuild_ubertrampoline(u32 id_inst)
 	}
 	while (!insert_to.compare_exchange(_old, result));
 
+	// Retire replaced ubertrampoline, it will be reused after all threads leave it
+	if (_old != tr_dispatch && jit_runtime::retire(reinterpret_cast<const void*>(_old)))
+	{
+		for (auto it = stuff_it; it != stuff_end; ++it)
+		{
+			it->trampoline.compare_and_swap(_old, nullptr);
+		}
+	}
+
 	return result;
 }
 
+void spu_runtime::reclaim(spu_thread& spu)
+{
+	// Minimal amount of retired memory worth suspending all threads
+	if (jit_runtime::get_retired_size() < 16 * 1024 * 1024)
+	{
+		return;
+	}
+
+	static shared_mutex s_reclaim_mutex;
+
+	std::unique_lock lock(s_reclaim_mutex, std::try_to_lock);
+
+	if (!lock)
+	{
+		return;
+	}
+
+	const u64 epoch = jit_runtime::next_epoch();
+
+	{
+		// Wait until no thread can be executing retired code
+		cpu_thread::suspend_all cpu_lock(&spu);
+	}
+
+	jit_runtime::reclaim(epoch);
+}
+
 spu_function_t spu_runtime::find(const u32* ls, u32 addr) const
 {
 	for (auto& item : m_stuff.at(ls[addr / 4] >> 12))
@@ -1096,6 +1138,8 @@ void spu_recompiler_base::dispatch(spu_thread& spu, void*, u8* rip)
 		return;
 	}
 
+	spu_runtime::reclaim(spu);
+
 	spu.jit->init();
 
 	// Compile
@@ -1206,6 +1250,11 @@ void spu_recompiler_base::old_interpreter(spu_thread& spu, void* ls, u8* rip)
 	}
 }
 
+bool spu_recompiler_base::ls_tracking()
+{
+	return g_cfg.core.spu_verification && g_cfg.core.spu_ls_tracking;
+}
+
 spu_program spu_recompiler_base::analyse(const be_t<u32>* ls, u32 entry_point)
 {
 	// Result: addr + raw instruction data
@@ -4319,6 +4368,45 @@ public:
 		}
 		else
 		{
+			// Block to proceed after successful verification
+			llvm::BasicBlock* label_pass = label_body;
+
+			if (ls_tracking())
+			{
+				// Skip verification if LS pages covered by the function weren't modified since last check
+				const auto label_check = BasicBlock::Create(m_context, "", m_function);
+				label_pass = BasicBlock::Create(m_context, "", m_function);
+
+				const u32 npages = std::min<u32>(((end - start - 1) >> 12) + 2, 64);
+				const auto page = m_ir->CreateLShr(m_ir->CreateAnd(get_pc(start), 0x3fffc), 12);
+
+				llvm::Value* gen_sum = m_ir->getInt64(0);
+
+				for (u32 i = 0; i < npages; i++)
+				{
+					const auto index = m_ir->CreateZExt(m_ir->CreateAnd(m_ir->CreateAdd(page, m_ir->getInt32(i)), 63), get_type<u64>());
+					gen_sum = m_ir->CreateAdd(gen_sum, m_ir->CreateLoad(m_ir->CreateGEP(spu_ptr<u64>(&spu_thread::ls_gen), index)));
+				}
+
+				const u32 slot = (m_hash_start >> 20) % 1024;
+				const auto tag = m_ir->CreateOr(m_ir->CreateZExt(m_base_pc, get_type<u64>()), m_ir->getInt64(m_hash_start & ~u64{0x3ffff}));
+				const auto ptag = spu_ptr<u64>(&spu_thread::ls_verify_tag, slot);
+				const auto pgen = spu_ptr<u64>(&spu_thread::ls_verify_gen, slot);
+				const auto same_tag = m_ir->CreateICmpEQ(m_ir->CreateLoad(ptag), tag);
+				const auto same_gen = m_ir->CreateICmpEQ(m_ir->CreateLoad(pgen), gen_sum);
+				m_ir->CreateCondBr(m_ir->CreateAnd(same_tag, same_gen), label_body, label_check, m_md_likely);
+
+				// Remember successful verification
+				m_ir->SetInsertPoint(label_pass);
+				m_ir->CreateStore(tag, ptag);
+				m_ir->CreateStore(gen_sum, pgen);
+				const auto precheck = spu_ptr<u64>(&spu_thread::block_recheck);
+				m_ir->CreateStore(m_ir->CreateAdd(m_ir->CreateLoad(precheck), m_ir->getInt64(1)), precheck);
+				m_ir->CreateBr(label_body);
+
+				m_ir->SetInsertPoint(label_check);
+			}
+
 			u32 starta = start;
 
 			// Skip holes at the beginning (giga only)
@@ -4400,7 +4488,7 @@ public:
 
 			// Compare result with zero
 			const auto cond = m_ir->CreateICmpNE(elem, m_ir->getInt64(0));
-			m_ir->CreateCondBr(cond, label_diff, label_body, m_md_unlikely);
+			m_ir->CreateCondBr(cond, label_diff, label_pass, m_md_unlikely);
 		}
 
 		// Increase block counter with statistics
@@ -5946,6 +6034,17 @@ public:
 						call("spu_memcpy", +spu_memcpy, dst, src, zext<u32>(size).eval(m_ir));
 					}
 
+					if (cmd & MFC_GET_CMD && csize && ls_tracking())
+					{
+						// Increment generation of the modified pages
+						auto spu_ls_write = [](spu_thread* _spu, u32 lsa, u32 size)
+						{
+							_spu->ls_write_notify(lsa & 0x3ffff, size);
+						};
+
+						call("spu_ls_write", +spu_ls_write, m_thread, lsa.value, zext<u32>(size).eval(m_ir));
+					}
+
 					m_ir->CreateBr(next);
 					break;
 				}
@@ -7031,6 +7130,14 @@ public:
 		}
 
 		const auto c = get_vr(op.rc);
+
+		if (m_use_avx512)
+		{
+			// Single vpternlogd (C ? B : A)
+			set_vr(op.rt4, vpternlogd(c, get_vr(op.rb), get_vr(op.ra), 0xca));
+			return;
+		}
+
 		set_vr(op.rt4, (get_vr(op.rb) & c) | (get_vr(op.ra) & ~c));
 	}
 
@@ -7138,6 +7245,15 @@ public:
 
 		const auto x = avg(noncast<u8[16]>(sext<s8[16]>((c & 0xc0) == 0xc0)), noncast<u8[16]>(sext<s8[16]>((c & 0xe0) == 0xc0)));
 		const auto cr = eval(c ^ 0xf);
+
+		if (m_use_vbmi)
+		{
+			// Select bytes from both registers with a single vpermi2b, then apply constants where bit 7 is set
+			const auto ab = vpermi2b(get_vr<u8[16]>(op.ra), cr, get_vr<u8[16]>(op.rb));
+			set_vr(op.rt4, select(noncast<s8[16]>(c) >= 0, ab, x));
+			return;
+		}
+
 		const auto a = pshufb(get_vr<u8[16]>(op.ra), cr);
 		const auto b = pshufb(get_vr<u8[16]>(op.rb), cr);
 		set_vr(op.rt4, select(noncast<s8[16]>(cr << 3) >= 0, a, b) | x);
@@ -7758,6 +7874,13 @@ public:
 	{
 		const auto bswapped = zshuffle(data, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
 		m_ir->CreateStore(bswapped.eval(m_ir), m_ir->CreateBitCast(m_ir->CreateGEP(m_lsptr, addr.value), get_type<u8(*)[16]>()), true);
+
+		if (ls_tracking())
+		{
+			// Increment generation of the modified page (address is already masked)
+			const auto pgen = m_ir->CreateGEP(spu_ptr<u64>(&spu_thread::ls_gen), m_ir->CreateLShr(addr.value, 12));
+			m_ir->CreateStore(m_ir->CreateAdd(m_ir->CreateLoad(pgen), m_ir->getInt64(1)), pgen);
+		}
 	}
 
 	auto make_load_ls(value_t<u64> addr)
@@ -119,6 +119,9 @@ public:
 	// Rebuild ubertrampoline for given identifier (first instruction)
 	spu_function_t rebuild_ubertrampoline(u32 id_inst);
 
+	// Reuse memory of replaced ubertrampolines (suspends all threads, must be called outside of compilation)
+	static void reclaim(spu_thread& spu);
+
 private:
 	friend class spu_cache;
 
@@ -318,6 +321,9 @@ public:
 	// Legacy interpreter loop
 	static void old_interpreter(spu_thread&, void* ls, u8*);
 
+	// Check whether compiled code tracks LS writes to skip verification of unchanged code
+	static bool ls_tracking();
+
 	// Get the function data at specified address
 	spu_program analyse(const be_t<u32>* ls, u32 lsa);
 
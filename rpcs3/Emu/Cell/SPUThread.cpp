@@ -846,7 +846,7 @@ std::string spu_thread::dump_misc() const
 {
 	std::string ret;
 
-	fmt::append(ret, "Block Weight: %u (Retreats: %u)", block_counter, block_failure);
+	fmt::append(ret, "Block Weight: %u (Retreats: %u; Rechecks: %u)", block_counter, block_failure, block_recheck);
 
 	if (g_cfg.core.spu_prof)
 	{
@@ -1061,6 +1061,9 @@ void spu_thread::cpu_task()
 
 	if (jit)
 	{
+		// LS could be written externally while the thread was stopped
+		ls_write_notify(0, 0x40000);
+
 		while (true)
 		{
 			if (state) [[unlikely]]
@@ -1080,7 +1083,7 @@ void spu_thread::cpu_task()
 		}
 
 		// Print some stats
-		spu_log.notice("Stats: Block Weight: %u (Retreats: %u);", block_counter, block_failure);
+		spu_log.notice("Stats: Block Weight: %u (Retreats: %u; Rechecks: %u);", block_counter, block_failure, block_recheck);
 	}
 	else
 	{
@@ -1143,6 +1146,8 @@ spu_thread::spu_thread(vm::addr_t ls, lv2_spu_group* group, u32 index, std::stri
 		jit = spu_recompiler_base::make_fast_llvm_recompiler();
 	}
 
+	ls_tracked = jit && spu_recompiler_base::ls_tracking();
+
 	if (g_cfg.core.spu_decoder != spu_decoder_type::fast && g_cfg.core.spu_decoder != spu_decoder_type::precise)
 	{
 		if (g_cfg.core.spu_block_size != spu_block_size_type::safe)
@@ -1174,6 +1179,19 @@ void spu_thread::push_snr(u32 number, u32 value)
 	}
 }
 
+void spu_thread::ls_write_notify(u32 lsa, u32 size)
+{
+	if (!size)
+	{
+		return;
+	}
+
+	for (u32 i = lsa / 4096, last = std::min<u32>((lsa + size - 1) / 4096, 63); i <= last; i++)
+	{
+		atomic_storage<u64>::fetch_add(ls_gen[i], 1);
+	}
+}
+
 void spu_thread::do_dma_transfer(const spu_mfc_cmd& args)
 {
 	const bool is_get = (args.cmd & ~(MFC_BARRIER_MASK | MFC_FENCE_MASK | MFC_START_MASK)) == MFC_GET_CMD;
@@ -1181,6 +1199,10 @@ void spu_thread::do_dma_transfer(const spu_mfc_cmd& args)
 	u32 eal = args.eal;
 	u32 lsa = args.lsa & 0x3ffff;
 
+	// Modified LS (notified after the transfer)
+	spu_thread* ls_target = is_get ? this : nullptr;
+	u32 ls_addr = lsa;
+
 	// SPU Thread Group MMIO (LS and SNR) and RawSPU MMIO
 	if (eal >= RAW_SPU_BASE_ADDR)
 	{
@@ -1200,10 +1222,16 @@ void spu_thread::do_dma_transfer(const spu_mfc_cmd& args)
 			u32 value;
 			if ((eal - RAW_SPU_BASE_ADDR) % RAW_SPU_OFFSET + args.size - 1 < 0x40000) // LS access
 			{
+				if (!is_get)
+				{
+					ls_target = thread.get();
+					ls_addr = (eal - RAW_SPU_BASE_ADDR) % RAW_SPU_OFFSET;
+				}
 			}
 			else if (args.size == 4 && is_get && thread->read_reg(eal, value))
 			{
 				_ref<u32>(lsa) = value;
+				ls_write_notify(lsa, 4);
 				return;
 			}
 			else if (args.size == 4 && !is_get && thread->write_reg(eal, _ref<u32>(lsa)))
@@ -1226,6 +1254,12 @@ void spu_thread::do_dma_transfer(const spu_mfc_cmd& args)
 			if (offset + args.size - 1 < 0x40000) // LS access
 			{
 				eal = spu.offset + offset; // redirect access
+
+				if (!is_get)
+				{
+					ls_target = &spu;
+					ls_addr = offset;
+				}
 			}
 			else if (!is_get && args.size == 4 && (offset == SYS_SPU_THREAD_SNR1 || offset == SYS_SPU_THREAD_SNR2))
 			{
@@ -1320,6 +1354,11 @@ void spu_thread::do_dma_transfer(const spu_mfc_cmd& args)
 					continue;
 				}
 
+				if (ls_target)
+				{
+					ls_target->ls_write_notify(ls_addr, args.size);
+				}
+
 				return;
 			}
 		}
@@ -1454,6 +1493,11 @@ void spu_thread::do_dma_transfer(const spu_mfc_cmd& args)
 		}
 		}
 
+		if (ls_target)
+		{
+			ls_target->ls_write_notify(ls_addr, args.size);
+		}
+
 		return;
 	}
 
@@ -1512,6 +1556,11 @@ void spu_thread::do_dma_transfer(const spu_mfc_cmd& args)
 		break;
 	}
 	}
+
+	if (ls_target)
+	{
+		ls_target->ls_write_notify(ls_addr, args.size);
+	}
 }
 
 bool spu_thread::do_dma_check(const spu_mfc_cmd& args)
@@ -1959,6 +2008,7 @@ bool spu_thread::process_mfc_cmd()
 		raddr = addr;
 		rtime = ntime;
 		mov_rdata(rdata, dst);
+		ls_write_notify(ch_mfc_cmd.lsa & 0x3ff80, 128);
 
 		ch_atomic_stat.set_value(MFC_GETLLAR_SUCCESS);
 		return true;
@@ -649,6 +649,18 @@ public:
 	u64 block_counter = 0;
 	u64 block_recover = 0;
 	u64 block_failure = 0;
+	u64 block_recheck = 0; // Code verifications caused by LS modifications
+
+	// LS write tracking: generation counter per 4K page, incremented on stores, DMA and external writes
+	std::array<u64, 64> ls_gen{};
+	bool ls_tracked = false; // Set if compiled code relies on ls_gen (interpreter stores skip it otherwise)
+
+	// Verified code cache: function hash | entry PC, and sum of generations of pages covered
+	std::array<u64, 1024> ls_verify_tag{};
+	std::array<u64, 1024> ls_verify_gen{};
+
+	// Mark LS range as modified (may be called from another thread)
+	void ls_write_notify(u32 lsa, u32 size);
 
 	u64 saved_native_sp = 0; // Host thread's stack pointer for emulated longjmp
 
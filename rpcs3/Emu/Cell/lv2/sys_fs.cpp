@@ -8,6 +8,11 @@
 #include "Emu/IdManager.h"
 #include "Utilities/StrUtil.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#include <errno.h>
+#endif
+
 LOG_CHANNEL(sys_fs);
 
 lv2_fs_mount_point g_mp_sys_dev_hdd0;
@@ -77,13 +82,58 @@ lv2_fs_mount_point* lv2_fs_object::get_mp(std::string_view filename)
 	return &g_mp_sys_dev_hdd0;
 }
 
+u64 lv2_file::op_read_direct(const fs::file& file, vm::ptr<void> buf, u64 size)
+{
+#ifdef _WIN32
+	// Not implemented: ReadFile leaves the file pointer undefined if the buffer faults
+	return 0;
+#else
+	const int fd = file.get_handle();
+
+	// Only real files, and only if the whole destination is mapped and writable
+	if (fd == -1 || size > UINT32_MAX || !vm::check_addr(buf.addr(), static_cast<u32>(size), vm::page_writable))
+	{
+		return 0;
+	}
+
+	u64 result = 0;
+
+	while (result < size)
+	{
+		// The read stops with EFAULT if it hits pages protected for access tracking (e.g. RSX texture cache)
+		// Those must be written by the intermediate buffer path so that the access violation handler runs
+		const ssize_t nread = ::read(fd, static_cast<uchar*>(buf.get_ptr()) + result, size - result);
+
+		if (nread <= 0)
+		{
+			if (nread < 0 && errno != EFAULT && errno != EINTR)
+			{
+				sys_fs.error("op_read_direct(): read() failed (errno=%d)", errno);
+			}
+
+			break;
+		}
+
+		result += nread;
+	}
+
+	return result;
+#endif
+}
+
 u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size)
 {
+	// Large reads go straight into guest memory
+	u64 result = size > 65536 ? op_read_direct(file, buf, size) : 0;
+
+	if (result)
+	{
+		sys_fs.trace("op_read(): read 0x%llx/0x%llx bytes directly", result, size);
+	}
+
 	// Copy data from intermediate buffer (avoid passing vm pointer to a native API)
 	uchar local_buf[65536];
 
-	u64 result = 0;
-
 	while (result < size)
 	{
 		const u64 block = std::min<u64>(size - result, sizeof(local_buf));
@@ -124,6 +174,102 @@ u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 	return result;
 }
 
+u64 lv2_file::op_read_at(const fs::file& file, u64 offset, vm::ptr<void> buf, u64 size)
+{
+#ifdef _WIN32
+	// Not implemented: ReadFile with OVERLAPPED offset still moves the file pointer of synchronous handles
+	return -1;
+#else
+	const int fd = file.get_handle();
+
+	if (fd == -1)
+	{
+		return -1;
+	}
+
+	// Copy data from intermediate buffer (avoid passing vm pointer to a native API)
+	uchar local_buf[65536];
+
+	u64 result = 0;
+
+	while (result < size)
+	{
+		const u64 block = std::min<u64>(size - result, sizeof(local_buf));
+		const ssize_t nread = ::pread(fd, +local_buf, block, offset + result);
+
+		if (nread < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (nread <= 0)
+		{
+			if (nread < 0)
+			{
+				sys_fs.error("op_read_at(): pread() failed (errno=%d)", errno);
+			}
+
+			break;
+		}
+
+		std::memcpy(static_cast<uchar*>(buf.get_ptr()) + result, local_buf, nread);
+		result += nread;
+	}
+
+	return result;
+#endif
+}
+
+u64 lv2_file::op_write_at(const fs::file& file, u64 offset, vm::cptr<void> buf, u64 size)
+{
+#ifdef _WIN32
+	return -1;
+#else
+	const int fd = file.get_handle();
+
+	if (fd == -1)
+	{
+		return -1;
+	}
+
+	// Copy data to intermediate buffer (avoid passing vm pointer to a native API)
+	uchar local_buf[65536];
+
+	u64 result = 0;
+
+	while (result < size)
+	{
+		const u64 block = std::min<u64>(size - result, sizeof(local_buf));
+		std::memcpy(local_buf, static_cast<const uchar*>(buf.get_ptr()) + result, block);
+		const ssize_t nwrite = ::pwrite(fd, +local_buf, block, offset + result);
+
+		if (nwrite < 0 && errno == EINTR)
+		{
+			continue;
+		}
+
+		if (nwrite <= 0)
+		{
+			if (nwrite < 0)
+			{
+				sys_fs.error("op_write_at(): pwrite() failed (errno=%d)", errno);
+			}
+
+			break;
+		}
+
+		result += nwrite;
+	}
+
+	return result;
+#endif
+}
+
+void lv2_file::invalidate_stat() const
+{
+	vfs::host::invalidate(vfs::get(name.data()));
+}
+
 struct lv2_file::file_view : fs::file_base
 {
 	const std::shared_ptr<lv2_file> m_file;
@@ -254,7 +400,7 @@ lv2_file::open_result_t lv2_file::open(std::string_view vpath, s32 flags, s32 mo
 
 	// TODO: other checks for path
 
-	if (fs::is_dir(local_path))
+	if (fs::stat_t info; vfs::host::stat(local_path, info) && info.is_directory)
 	{
 		return {CELL_EISDIR, path};
 	}
@@ -333,6 +479,11 @@ lv2_file::open_result_t lv2_file::open(std::string_view vpath, s32 flags, s32 mo
 	{
 		std::lock_guard lock(mp->mutex);
 		file.open(local_path, open_mode);
+
+		if (open_mode & (fs::create + fs::trunc))
+		{
+			vfs::host::invalidate(local_path);
+		}
 	}
 
 	if (!file && open_mode == fs::read && fs::g_tls_error == fs::error::noent)
@@ -834,7 +985,7 @@ error_code sys_fs_stat(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<CellFsStat>
 
 	fs::stat_t info{};
 
-	if (!fs::stat(local_path, info))
+	if (!vfs::host::stat(local_path, info))
 	{
 		switch (auto error = fs::g_tls_error)
 		{
@@ -984,6 +1135,7 @@ error_code sys_fs_mkdir(ppu_thread& ppu, vm::cptr<char> path, s32 mode)
 		return {CELL_EIO, path}; // ???
 	}
 
+	vfs::host::invalidate(local_path);
 	sys_fs.notice("sys_fs_mkdir(): directory %s created", path);
 	return CELL_OK;
 }
@@ -1086,6 +1238,7 @@ error_code sys_fs_rmdir(ppu_thread& ppu, vm::cptr<char> path)
 		return {CELL_EIO, path}; // ???
 	}
 
+	vfs::host::invalidate(local_path, true);
 	sys_fs.notice("sys_fs_rmdir(): directory %s removed", path);
 	return CELL_OK;
 }
@@ -1765,6 +1918,7 @@ error_code sys_fs_truncate(ppu_thread& ppu, vm::cptr<char> path, u64 size)
 		return {CELL_EIO, path}; // ???
 	}
 
+	vfs::host::invalidate(local_path);
 	return CELL_OK;
 }
 
@@ -1809,6 +1963,7 @@ error_code sys_fs_ftruncate(ppu_thread& ppu, u32 fd, u64 size)
 		return CELL_EIO; // ???
 	}
 
+	file->invalidate_stat();
 	return CELL_OK;
 }
 
@@ -1951,6 +2106,7 @@ error_code sys_fs_utime(ppu_thread& ppu, vm::cptr<char> path, vm::cptr<CellFsUti
 		return {CELL_EIO, path}; // ???
 	}
 
+	vfs::host::invalidate(local_path);
 	return CELL_OK;
 }
 
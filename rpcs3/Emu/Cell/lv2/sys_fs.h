@@ -224,6 +224,9 @@ struct lv2_file final : lv2_fs_object
 	// File reading with intermediate buffer
 	static u64 op_read(const fs::file& file, vm::ptr<void> buf, u64 size);
 
+	// File reading directly into guest memory, returns the amount read before stopping (EOF, fault or unsupported file)
+	static u64 op_read_direct(const fs::file& file, vm::ptr<void> buf, u64 size);
+
 	u64 op_read(vm::ptr<void> buf, u64 size)
 	{
 		return op_read(file, buf, size);
@@ -232,9 +235,18 @@ struct lv2_file final : lv2_fs_object
 	// File writing with intermediate buffer
 	static u64 op_write(const fs::file& file, vm::cptr<void> buf, u64 size);
 
+	// Drop cached stat of the host file (see vfs::host::stat), must be called after modifying it
+	void invalidate_stat() const;
+
+	// Positional file reading/writing which doesn't move the file position (returns -1 if not supported for this file)
+	static u64 op_read_at(const fs::file& file, u64 offset, vm::ptr<void> buf, u64 size);
+	static u64 op_write_at(const fs::file& file, u64 offset, vm::cptr<void> buf, u64 size);
+
 	u64 op_write(vm::cptr<void> buf, u64 size)
 	{
-		return op_write(file, buf, size);
+		const u64 result = op_write(file, buf, size);
+		invalidate_stat();
+		return result;
 	}
 
 	// For MSELF support
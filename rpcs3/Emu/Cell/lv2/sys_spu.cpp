@@ -1259,6 +1259,8 @@ error_code sys_spu_thread_write_ls(ppu_thread& ppu, u32 id, u32 lsa, u64 value,
 	default: ASSUME(0);
 	}
 
+	thread->ls_write_notify(lsa, type);
+
 	return CELL_OK;
 }
 
@@ -593,6 +593,61 @@ void PadHandlerBase::get_mapping(const std::shared_ptr<PadDevice>& device, const
 	}
 }
 
+void PadHandlerBase::publish_input(const std::shared_ptr<Pad>& pad)
+{
+	// Keep the oldest timestamp so that the latency covers the whole time the input waited for the guest
+	pad->m_input_timestamp.compare_and_swap(0, get_system_time());
+}
+
+void PadHandlerBase::get_input_state(const Pad& pad, std::vector<u16>& state)
+{
+	state.clear();
+
+	for (const Button& button : pad.m_buttons)
+	{
+		state.push_back(button.m_value);
+		state.push_back(button.m_pressed);
+	}
+
+	for (const AnalogStick& stick : pad.m_sticks)
+	{
+		state.push_back(stick.m_value);
+	}
+}
+
+bool PadHandlerBase::has_input_changed(const Pad& pad, const std::vector<u16>& state)
+{
+	if (state.size() != pad.m_buttons.size() * 2 + pad.m_sticks.size())
+	{
+		return true;
+	}
+
+	auto it = state.begin();
+
+	for (const Button& button : pad.m_buttons)
+	{
+		if (*it++ != button.m_value || *it++ != button.m_pressed)
+		{
+			return true;
+		}
+	}
+
+	for (const AnalogStick& stick : pad.m_sticks)
+	{
+		if (*it++ != stick.m_value)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void PadHandlerBase::wait_for_input()
+{
+	std::this_thread::sleep_for(1ms);
+}
+
 void PadHandlerBase::ThreadProc()
 {
 	for (size_t i = 0; i < bindings.size(); ++i)
@@ -640,8 +695,15 @@ void PadHandlerBase::ThreadProc()
 			break;
 		}
 
+		get_input_state(*pad, m_input_state);
+
 		get_mapping(device, pad);
 		get_extended_info(device, pad);
 		apply_pad_data(device, pad);
+
+		if (status == connection::connected && has_input_changed(*pad, m_input_state))
+		{
+			publish_input(pad);
+		}
 	}
 }
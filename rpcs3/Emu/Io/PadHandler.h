@@ -75,6 +75,7 @@ protected:
 	std::vector<std::pair<std::shared_ptr<PadDevice>, std::shared_ptr<Pad>>> bindings;
 	std::unordered_map<u32, std::string> button_list;
 	std::vector<u32> blacklist;
+	std::vector<u16> m_input_state; // Pad state before the last poll (see get_input_state)
 
 	// Search an unordered map for a string value and return found keycode
 	static int FindKeyCode(const std::unordered_map<u32, std::string>& map, const cfg::string& name, bool fallback = true);
@@ -116,6 +117,13 @@ protected:
 	// input has to be [-1,1]. result will be [0,255]
 	static u16 ConvertAxis(float value);
 
+	// Marks the arrival of a button or axis change for the input latency statistics
+	static void publish_input(const std::shared_ptr<Pad>& pad);
+
+	// Copies the button and stick values of a pad, so that only actual changes are published
+	static void get_input_state(const Pad& pad, std::vector<u16>& state);
+	static bool has_input_changed(const Pad& pad, const std::vector<u16>& state);
+
 	// The DS3, (and i think xbox controllers) give a 'square-ish' type response, so that the corners will give (almost)max x/y instead of the ~30x30 from a perfect circle
 	// using a simple scale/sensitivity increase would *work* although it eats a chunk of our usable range in exchange
 	// this might be the best for now, in practice it seems to push the corners to max of 20x20, with a squircle_factor of 8000
@@ -152,8 +160,10 @@ public:
 	virtual u32 get_battery_level(const std::string& /*padId*/) { return 0; }
 	// Return list of devices for that handler
 	virtual std::vector<std::string> ListDevices() = 0;
-	// Callback called during pad_thread::ThreadFunc
+	// Callback called by the handler's thread in pad_thread
 	virtual void ThreadProc();
+	// Blocks the handler's thread until new input may be available
+	virtual void wait_for_input();
 	// Binds a Pad to a device
 	virtual bool bindPadToDevice(std::shared_ptr<Pad> pad, const std::string& device);
 	virtual void init_config(pad_config* /*cfg*/, const std::string& /*name*/) = 0;
@@ -292,6 +292,9 @@ struct Pad
 	bool ldd = false;
 	u8 ldd_data[132] = {};
 
+	// Time of the oldest button or axis change which was not read by the guest yet (0 if none)
+	atomic_t<u64> m_input_timestamp{0};
+
 	void Init(u32 port_status, u32 device_capability, u32 device_type, u32 class_type, u32 class_profile, u16 vendor_id, u16 product_id)
 	{
 		m_port_status = port_status;
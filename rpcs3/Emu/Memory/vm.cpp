@@ -738,10 +738,144 @@ namespace vm
 
 		// Add entry
 		m_map[addr] = std::make_pair(size, std::move(shm));
+		m_used += page_size;
 
 		return true;
 	}
 
+	bool block_t::reserve_range(u32& addr, u32 size, u32 align, u32 min_addr)
+	{
+		std::lock_guard lock(m_free_mutex);
+
+		// Start from the free range containing min_addr
+		auto it = m_free.upper_bound(min_addr);
+
+		if (it != m_free.begin())
+		{
+			it--;
+		}
+
+		// Lowest suitable address, same result as probing every aligned address
+		for (; it != m_free.end(); it++)
+		{
+			if (it->second < size)
+			{
+				continue;
+			}
+
+			const u64 start = ::align<u64>(std::max(it->first, min_addr), align);
+
+			if (start + size > u64{it->first} + it->second)
+			{
+				continue;
+			}
+
+			const u32 range_addr = it->first;
+			const u32 range_size = it->second;
+
+			// Split free range
+			m_free.erase(it);
+
+			if (start > range_addr)
+			{
+				m_free.emplace(range_addr, static_cast<u32>(start - range_addr));
+			}
+
+			if (start + size < u64{range_addr} + range_size)
+			{
+				m_free.emplace(static_cast<u32>(start + size), static_cast<u32>(range_addr + u64{range_size} - start - size));
+			}
+
+			addr = static_cast<u32>(start);
+			m_reserved += size;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool block_t::reserve_fixed(u32 addr, u32 size)
+	{
+		std::lock_guard lock(m_free_mutex);
+
+		const auto upper = m_free.upper_bound(addr);
+
+		if (upper == m_free.begin())
+		{
+			return false;
+		}
+
+		const auto found = std::prev(upper);
+
+		const u32 range_addr = found->first;
+		const u32 range_size = found->second;
+
+		if (u64{addr} + size > u64{range_addr} + range_size)
+		{
+			return false;
+		}
+
+		m_free.erase(found);
+
+		if (addr > range_addr)
+		{
+			m_free.emplace(range_addr, addr - range_addr);
+		}
+
+		if (u64{addr} + size < u64{range_addr} + range_size)
+		{
+			m_free.emplace(addr + size, static_cast<u32>(range_addr + u64{range_size} - addr - size));
+		}
+
+		m_reserved += size;
+		return true;
+	}
+
+	void block_t::release_range(u32 addr, u32 size)
+	{
+		std::lock_guard lock(m_free_mutex);
+
+		const auto next = m_free.lower_bound(addr);
+
+		// Merge with adjacent free ranges
+		if (next != m_free.begin())
+		{
+			const auto prev = std::prev(next);
+
+			if (prev->first + u64{prev->second} == addr)
+			{
+				addr = prev->first;
+				size += prev->second;
+				m_free.erase(prev);
+			}
+		}
+
+		if (next != m_free.end() && addr + u64{size} == next->first)
+		{
+			size += next->second;
+			m_free.erase(next);
+		}
+
+		m_free.emplace(addr, size);
+	}
+
+	void block_t::add_alloc_time(u64 ns)
+	{
+		m_alloc_count++;
+		m_alloc_ns += ns;
+
+		m_alloc_max_ns.fetch_op([&](u64& max)
+		{
+			if (max < ns)
+			{
+				max = ns;
+				return true;
+			}
+
+			return false;
+		});
+	}
+
 	block_t::block_t(u32 addr, u32 size, u64 flags)
 		: addr(addr)
 		, size(size)
@@ -754,10 +888,20 @@ namespace vm
 			verify(HERE), m_common->map_critical(vm::base(addr), utils::protection::no) == vm::base(addr);
 			verify(HERE), m_common->map_critical(vm::get_super_ptr(addr)) == vm::get_super_ptr(addr);
 		}
+
+		if (size)
+		{
+			m_free.emplace(addr, size);
+		}
 	}
 
 	block_t::~block_t()
 	{
+		if (const u64 count = m_alloc_count)
+		{
+			vm_log.notice("Block 0x%x: %u allocations, avg %u ns, max %u ns", addr, count, m_alloc_ns / count, +m_alloc_max_ns);
+		}
+
 		{
 			vm::writer_lock lock(0);
 
@@ -787,7 +931,7 @@ namespace vm
 			flags = this->flags;
 		}
 
-		vm::writer_lock lock(0);
+		const auto stamp0 = std::chrono::steady_clock::now();
 
 		// Determine minimal alignment
 		const u32 min_page_size = flags & 0x100 ? 0x1000 : 0x10000;
@@ -828,16 +972,43 @@ namespace vm
 		else
 			shm = std::make_shared<utils::shm>(size);
 
-		// Search for an appropriate place (unoptimized)
-		for (u32 addr = ::align(this->addr, align); u64{addr} + size <= u64{this->addr} + this->size; addr += align)
+		// Search for an appropriate place without stopping other threads
+		u32 addr = this->addr;
+
+		while (true)
 		{
-			if (try_alloc(addr, pflags, size, std::move(shm)))
+			if (!reserve_range(addr, size, align, addr))
 			{
-				return addr + (flags & 0x10 ? 0x1000 : 0);
+				return 0;
 			}
+
+			bool ok;
+			{
+				vm::writer_lock lock(0);
+
+				ok = try_alloc(addr, pflags, size, std::move(shm));
+				m_reserved -= size;
+			}
+
+			if (ok)
+			{
+				break;
+			}
+
+			// Pages are mapped outside of the block's bookkeeping, try the next aligned address
+			release_range(addr, size);
+
+			if (addr + u64{align} + size > this->addr + u64{this->size})
+			{
+				return 0;
+			}
+
+			addr += align;
 		}
 
-		return 0;
+		add_alloc_time(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - stamp0).count());
+
+		return addr + (flags & 0x10 ? 0x1000 : 0);
 	}
 
 	u32 block_t::falloc(u32 addr, const u32 orig_size, const std::shared_ptr<utils::shm>* src, u64 flags)
@@ -848,7 +1019,7 @@ namespace vm
 			flags = this->flags;
 		}
 
-		vm::writer_lock lock(0);
+		const auto stamp0 = std::chrono::steady_clock::now();
 
 		// Determine minimal alignment
 		const u32 min_page_size = flags & 0x100 ? 0x1000 : 0x10000;
@@ -883,16 +1054,33 @@ namespace vm
 		else
 			shm = std::make_shared<utils::shm>(size);
 
-		if (!try_alloc(addr, pflags, size, std::move(shm)))
+		if (!reserve_fixed(addr, size))
+		{
+			return 0;
+		}
+
+		bool ok;
+		{
+			vm::writer_lock lock(0);
+
+			ok = try_alloc(addr, pflags, size, std::move(shm));
+			m_reserved -= size;
+		}
+
+		if (!ok)
 		{
+			release_range(addr, size);
 			return 0;
 		}
 
+		add_alloc_time(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - stamp0).count());
+
 		return addr;
 	}
 
 	u32 block_t::dealloc(u32 addr, const std::shared_ptr<utils::shm>* src)
 	{
+		u32 size, range_addr, range_size;
 		{
 			vm::writer_lock lock(0);
 
@@ -909,7 +1097,9 @@ namespace vm
 			}
 
 			// Get allocation size
-			const auto size = found->second.first - (flags & 0x10 ? 0x2000 : 0);
+			size = found->second.first - (flags & 0x10 ? 0x2000 : 0);
+			range_addr = found->first;
+			range_size = found->second.first;
 
 			if (flags & 0x10)
 			{
@@ -923,9 +1113,13 @@ namespace vm
 
 			// Remove entry
 			m_map.erase(found);
-
-			return size;
+			m_used -= size;
 		}
+
+		// Make the range available again (after page tables are updated)
+		release_range(range_addr, range_size);
+
+		return size;
 	}
 
 	std::pair<u32, std::shared_ptr<utils::shm>> block_t::get(u32 addr, u32 size)
@@ -969,21 +1163,13 @@ namespace vm
 
 	u32 block_t::imp_used(const vm::writer_lock&)
 	{
-		u32 result = 0;
-
-		for (auto& entry : m_map)
-		{
-			result += entry.second.first - (flags & 0x10 ? 0x2000 : 0);
-		}
-
-		return result;
+		// Include ranges reserved by allocations in progress
+		return m_used + m_reserved;
 	}
 
 	u32 block_t::used()
 	{
-		vm::writer_lock lock(0);
-
-		return imp_used(lock);
+		return m_used;
 	}
 
 	static bool _test_map(u32 addr, u32 size)
@@ -6,6 +6,7 @@
 #include "Utilities/VirtualMemory.h"
 #include "Utilities/StrFmt.h"
 #include "Utilities/BEType.h"
+#include "Utilities/mutex.h"
 
 namespace vm
 {
@@ -75,8 +76,35 @@ namespace vm
 		// Common mapped region for special cases
 		std::shared_ptr<utils::shm> m_common;
 
+		// Unreserved regions: addr -> size (protected by m_free_mutex, never held with vm::writer_lock)
+		std::map<u32, u32> m_free;
+
+		shared_mutex m_free_mutex;
+
+		// Allocated memory count (excluding guard pages)
+		atomic_t<u32> m_used{0};
+
+		// Memory reserved in m_free but not mapped yet (updated under vm::writer_lock on commit)
+		atomic_t<u32> m_reserved{0};
+
+		// Allocation statistics
+		atomic_t<u64> m_alloc_count{0};
+		atomic_t<u64> m_alloc_ns{0};
+		atomic_t<u64> m_alloc_max_ns{0};
+
 		bool try_alloc(u32 addr, u8 flags, u32 size, std::shared_ptr<utils::shm>&&);
 
+		// Reserve first suitable free range not below min_addr (returns false if not found)
+		bool reserve_range(u32& addr, u32 size, u32 align, u32 min_addr);
+
+		// Reserve free range at fixed location
+		bool reserve_fixed(u32 addr, u32 size);
+
+		// Return range to the free list
+		void release_range(u32 addr, u32 size);
+
+		void add_alloc_time(u64 ns);
+
 	public:
 		block_t(u32 addr, u32 size, u64 flags = 0);
 
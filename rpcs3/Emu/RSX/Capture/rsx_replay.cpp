@@ -174,10 +174,15 @@ namespace rsx
 
 		auto fifo_stops = alloc_write_fifo(context_id);
 
+		// Replay timing, the captured command stream doubles as a FIFO benchmark
+		u64 replay_count = 0;
+		u64 replay_time = 0;
+
 		while (!Emu.IsStopped())
 		{
 			// Load registers while the RSX is still idle
 			method_registers = frame->reg_state;
+			get_current_renderer()->m_transform_program_generation++;
 			std::atomic_thread_fence(std::memory_order_seq_cst);
 
 			// start up fifo buffer by dumping the put ptr to first stop
@@ -186,6 +191,8 @@ namespace rsx
 			auto render = get_current_renderer();
 			auto last_flip = render->int_flip_index;
 
+			const u64 replay_start = get_system_time();
+
 			size_t stopIdx = 0;
 			for (const auto& replay_cmd : frame->replay_commands)
 			{
@@ -228,6 +235,13 @@ namespace rsx
 					std::this_thread::sleep_for(10ms);
 			}
 
+			replay_time += get_system_time() - replay_start;
+
+			if (++replay_count % 100 == 0)
+			{
+				rsx_log.notice("Capture Replay: %u frames, average FIFO time %.3f ms", replay_count, replay_time / (replay_count * 1000.));
+			}
+
 			// Check if the captured application used syscall instead of a gcm command to flip
 			if (render->int_flip_index == last_flip)
 			{
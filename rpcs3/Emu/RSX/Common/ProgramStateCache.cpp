@@ -249,7 +249,7 @@ vertex_program_utils::vertex_program_metadata vertex_program_utils::analyse_vert
 
 size_t vertex_program_storage_hash::operator()(const RSXVertexProgram &program) const
 {
-	size_t hash = vertex_program_utils::get_vertex_program_ucode_hash(program);
+	size_t hash = program.ucode_hash ? program.ucode_hash : vertex_program_utils::get_vertex_program_ucode_hash(program);
 	hash ^= program.output_mask;
 	hash ^= program.texture_dimensions;
 	return hash;
@@ -448,7 +448,7 @@ size_t fragment_program_utils::get_fragment_program_ucode_hash(const RSXFragment
 
 size_t fragment_program_storage_hash::operator()(const RSXFragmentProgram& program) const
 {
-	size_t hash = fragment_program_utils::get_fragment_program_ucode_hash(program);
+	size_t hash = program.ucode_hash ? program.ucode_hash : fragment_program_utils::get_fragment_program_ucode_hash(program);
 	hash ^= program.ctrl;
 	hash ^= program.texture_dimensions;
 	hash ^= program.unnormalized_coords;
@@ -498,3 +498,84 @@ bool fragment_program_compare::operator()(const RSXFragmentProgram& binary1, con
 			return true;
 	}
 }
+
+bool vertex_program_analysis_cache::lookup(const u32* data, u32 start, u32 generation, vertex_program_utils::vertex_program_metadata& metadata, RSXVertexProgram& dst)
+{
+	for (auto& e : m_entries)
+	{
+		if (e.start != start)
+		{
+			continue;
+		}
+
+		if (e.generation != generation)
+		{
+			// Transform program was written to since, only reuse the entry if the analysed range is intact
+			if (std::memcmp(data + e.program.base_address * 4, e.ucode.data(), e.ucode.size() * sizeof(u32)) != 0)
+			{
+				e.start = UINT32_MAX;
+				return false;
+			}
+
+			e.generation = generation;
+		}
+
+		metadata = e.metadata;
+		dst.base_address = e.program.base_address;
+		dst.entry = e.program.entry;
+		dst.data = e.program.data;
+		dst.instruction_mask = e.program.instruction_mask;
+		dst.jump_table = e.program.jump_table;
+		dst.ucode_hash = e.program.ucode_hash;
+		return true;
+	}
+
+	return false;
+}
+
+void vertex_program_analysis_cache::store(const u32* data, u32 start, u32 generation, const vertex_program_utils::vertex_program_metadata& metadata, const RSXVertexProgram& src)
+{
+	auto& e = m_entries[m_next++ % m_entries.size()];
+	e.start = start;
+	e.generation = generation;
+	e.ucode.assign(data + src.base_address * 4, data + src.base_address * 4 + src.data.size());
+	e.metadata = metadata;
+	e.program.base_address = src.base_address;
+	e.program.entry = src.entry;
+	e.program.data = src.data;
+	e.program.instruction_mask = src.instruction_mask;
+	e.program.jump_table = src.jump_table;
+	e.program.ucode_hash = src.ucode_hash;
+}
+
+bool fragment_program_analysis_cache::lookup(u32 address, const void* data, fragment_program_utils::fragment_program_metadata& metadata, u64& ucode_hash)
+{
+	for (auto& e : m_entries)
+	{
+		if (e.address != address)
+		{
+			continue;
+		}
+
+		if (std::memcmp(data, e.ucode.data(), e.ucode.size()) != 0)
+		{
+			e.address = UINT32_MAX;
+			return false;
+		}
+
+		metadata = e.metadata;
+		ucode_hash = e.ucode_hash;
+		return true;
+	}
+
+	return false;
+}
+
+void fragment_program_analysis_cache::store(u32 address, const void* data, const fragment_program_utils::fragment_program_metadata& metadata, u64 ucode_hash)
+{
+	auto& e = m_entries[m_next++ % m_entries.size()];
+	e.address = address;
+	e.ucode_hash = ucode_hash;
+	e.ucode.assign(static_cast<const u8*>(data), static_cast<const u8*>(data) + metadata.program_start_offset + metadata.program_ucode_length);
+	e.metadata = metadata;
+}
@@ -77,6 +77,52 @@ namespace program_hash_util
 	{
 		bool operator()(const RSXFragmentProgram &binary1, const RSXFragmentProgram &binary2) const;
 	};
+
+	/**
+	 * Remembers recent vertex program analysis results keyed by entry point.
+	 * An entry is trusted as long as the transform program generation is unchanged,
+	 * after an upload the analysed ucode range is compared against the saved copy instead.
+	 */
+	class vertex_program_analysis_cache
+	{
+		struct entry
+		{
+			u32 start = UINT32_MAX;
+			u32 generation = 0;
+			std::vector<u32> ucode;
+			vertex_program_utils::vertex_program_metadata metadata{};
+			RSXVertexProgram program{};
+		};
+
+		std::array<entry, 16> m_entries;
+		u32 m_next = 0;
+
+	public:
+		bool lookup(const u32* data, u32 start, u32 generation, vertex_program_utils::vertex_program_metadata& metadata, RSXVertexProgram& dst);
+		void store(const u32* data, u32 start, u32 generation, const vertex_program_utils::vertex_program_metadata& metadata, const RSXVertexProgram& src);
+	};
+
+	/**
+	 * Remembers recent fragment program analysis results keyed by ucode address.
+	 * Guest memory writes are not tracked, so a hit always requires the ucode to match the saved copy.
+	 */
+	class fragment_program_analysis_cache
+	{
+		struct entry
+		{
+			u32 address = UINT32_MAX;
+			u64 ucode_hash = 0;
+			std::vector<u8> ucode;
+			fragment_program_utils::fragment_program_metadata metadata{};
+		};
+
+		std::array<entry, 16> m_entries;
+		u32 m_next = 0;
+
+	public:
+		bool lookup(u32 address, const void* data, fragment_program_utils::fragment_program_metadata& metadata, u64& ucode_hash);
+		void store(u32 address, const void* data, const fragment_program_utils::fragment_program_metadata& metadata, u64 ucode_hash);
+	};
 }
 
 
@@ -6,6 +6,7 @@
 #include "../rsx_utils.h"
 #include "Utilities/span.h"
 #include <list>
+#include <map>
 
 namespace rsx
 {
@@ -16,6 +17,75 @@ namespace rsx
 		size_t get_packed_pitch(surface_color_format format, u32 width);
 	}
 
+	// Surface storage ordered by base address, allows overlap queries without visiting every surface
+	template <typename surface_storage_type>
+	class surface_ranged_map
+	{
+		using container_type = std::map<u32, surface_storage_type>;
+
+		container_type m_data;
+
+		// Largest memory range length of any surface inserted since the last clear
+		u32 m_max_length = 0;
+
+		void update_max_length(const surface_storage_type& surface)
+		{
+			if (surface)
+			{
+				m_max_length = std::max(m_max_length, surface->get_memory_range().length());
+			}
+		}
+
+	public:
+		using iterator = typename container_type::iterator;
+		using const_iterator = typename container_type::const_iterator;
+
+		iterator begin() { return m_data.begin(); }
+		iterator end() { return m_data.end(); }
+		const_iterator begin() const { return m_data.begin(); }
+		const_iterator end() const { return m_data.end(); }
+
+		bool empty() const { return m_data.empty(); }
+		size_t size() const { return m_data.size(); }
+
+		iterator find(u32 address) { return m_data.find(address); }
+
+		iterator erase(iterator it) { return m_data.erase(it); }
+		size_t erase(u32 address) { return m_data.erase(address); }
+
+		void clear()
+		{
+			m_data.clear();
+			m_max_length = 0;
+		}
+
+		// Insert or replace the surface at address
+		void emplace(u32 address, surface_storage_type&& surface)
+		{
+			update_max_length(surface);
+			m_data[address] = std::move(surface);
+		}
+
+		// Must be called when the memory range of a stored surface changes
+		void update(iterator it)
+		{
+			update_max_length(it->second);
+		}
+
+		// Iterator range of all surfaces which may overlap range (surfaces still need to be range tested)
+		std::pair<iterator, iterator> find_overlapping(const rsx::address_range& range)
+		{
+			if (m_data.empty() || !range.valid())
+			{
+				return { m_data.end(), m_data.end() };
+			}
+
+			// A surface can only overlap if it starts less than m_max_length bytes before the range
+			const u32 lookback = std::min(range.start, std::max(m_max_length, 1u) - 1);
+			return { m_data.lower_bound(range.start - lookback), m_data.upper_bound(range.end) };
+		}
+	};
+
 	template<typename Traits>
 	struct surface_store
 	{
@@ -43,8 +113,8 @@ namespace rsx
 		using surface_overlap_info = surface_overlap_info_t<surface_type>;
 
 	protected:
-		std::unordered_map<u32, surface_storage_type> m_render_targets_storage = {};
-		std::unordered_map<u32, surface_storage_type> m_depth_stencil_storage = {};
+		surface_ranged_map<surface_storage_type> m_render_targets_storage = {};
+		surface_ranged_map<surface_storage_type> m_depth_stencil_storage = {};
 
 		rsx::address_range m_render_targets_memory_range;
 		rsx::address_range m_depth_stencil_memory_range;
@@ -76,7 +146,7 @@ namespace rsx
 			auto insert_new_surface = [&](
 				u32 new_address,
 				deferred_clipped_region<surface_type>& region,
-				std::unordered_map<u32, surface_storage_type>& data)
+				surface_ranged_map<surface_storage_type>& data)
 			{
 				surface_storage_type sink;
 				surface_type invalidated = 0;
@@ -137,7 +207,7 @@ namespace rsx
 
 				verify(HERE), region.target == Traits::get(sink);
 				orphaned_surfaces.push_back(region.target);
-				data[new_address] = std::move(sink);
+				data.emplace(new_address, std::move(sink));
 			};
 
 			// Define incoming region
@@ -225,11 +295,12 @@ namespace rsx
 		void intersect_surface_region(command_list_type cmd, u32 address, surface_type new_surface, surface_type prev_surface)
 		{
 			auto scan_list = [&new_surface, address](const rsx::address_range& mem_range,
-				std::unordered_map<u32, surface_storage_type>& data) -> std::vector<std::pair<u32, surface_type>>
+				surface_ranged_map<surface_storage_type>& data) -> std::vector<std::pair<u32, surface_type>>
 			{
 				std::vector<std::pair<u32, surface_type>> result;
-				for (const auto &e : data)
+				for (auto [It, end] = data.find_overlapping(mem_range); It != end; ++It)
 				{
+					const auto& e = *It;
 					auto surface = Traits::get(e.second);
 
 					if (new_surface->last_use_tag >= surface->last_use_tag ||
@@ -392,7 +463,7 @@ namespace rsx
 				{
 					// This has been 'swallowed' by the new surface and can be safely freed
 					auto &storage = surface->is_depth_surface() ? m_depth_stencil_storage : m_render_targets_storage;
-					auto &object = storage[e.first];
+					auto &object = storage.find(e.first)->second;
 
 					verify(HERE), !src_offset.x, !src_offset.y, object;
 					if (!surface->old_contents.empty()) [[unlikely]]
@@ -425,7 +496,7 @@ namespace rsx
 			bool store = true;
 
 			address_range *storage_bounds;
-			std::unordered_map<u32, surface_storage_type> *primary_storage, *secondary_storage;
+			surface_ranged_map<surface_storage_type> *primary_storage, *secondary_storage;
 			if constexpr (depth)
 			{
 				primary_storage = &m_depth_stencil_storage;
@@ -449,9 +520,14 @@ namespace rsx
 				if (Traits::surface_matches_properties(surface, format, width, height, antialias))
 				{
 					if (pitch_compatible)
+					{
 						Traits::notify_surface_persist(surface);
+					}
 					else
+					{
 						Traits::invalidate_surface_contents(command_list, Traits::get(surface), address, pitch);
+						primary_storage->update(It);
+					}
 
 					Traits::prepare_surface_for_drawing(command_list, Traits::get(surface));
 					new_surface = Traits::get(surface);
@@ -574,7 +650,7 @@ namespace rsx
 			if (store)
 			{
 				// New surface was found among invalidated surfaces or created from scratch
-				(*primary_storage)[address] = std::move(new_surface_storage);
+				primary_storage->emplace(address, std::move(new_surface_storage));
 			}
 
 			verify(HERE), !old_surface_storage, new_surface->get_spp() == get_format_sample_count(antialias);
@@ -800,10 +876,11 @@ namespace rsx
 
 			const auto test_range = utils::address_range::start_length(texaddr, (required_pitch * required_height) - (required_pitch - surface_internal_pitch));
 
-			auto process_list_function = [&](std::unordered_map<u32, surface_storage_type>& data, bool is_depth)
+			auto process_list_function = [&](surface_ranged_map<surface_storage_type>& data, bool is_depth)
 			{
-				for (auto& tex_info : data)
+				for (auto [It, end] = data.find_overlapping(test_range); It != end; ++It)
 				{
+					auto& tex_info = *It;
 					const auto range = tex_info.second->get_memory_range();
 					if (!range.overlaps(test_range))
 						continue;
@@ -1019,8 +1096,9 @@ namespace rsx
 
 		void invalidate_range(const rsx::address_range& range)
 		{
-			for (auto &rtt : m_render_targets_storage)
+			for (auto [It, end] = m_render_targets_storage.find_overlapping(range); It != end; ++It)
 			{
+				auto &rtt = *It;
 				if (range.overlaps(rtt.second->get_memory_range()))
 				{
 					rtt.second->clear_rw_barrier();
@@ -1028,8 +1106,9 @@ namespace rsx
 				}
 			}
 
-			for (auto &ds : m_depth_stencil_storage)
+			for (auto [It, end] = m_depth_stencil_storage.find_overlapping(range); It != end; ++It)
 			{
+				auto &ds = *It;
 				if (range.overlaps(ds.second->get_memory_range()))
 				{
 					ds.second->clear_rw_barrier();
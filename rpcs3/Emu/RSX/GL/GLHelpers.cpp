@@ -175,6 +175,13 @@ namespace gl
 		return g_driver_caps;
 	}
 
+	void init_offline_driver_caps()
+	{
+		// No context is available, decompile against the baseline feature set
+		g_driver_caps = {};
+		g_driver_caps.initialized = true;
+	}
+
 	void fbo::create()
 	{
 		glGenFramebuffers(1, &m_id);
@@ -53,6 +53,7 @@ namespace gl
 
 	void enable_debugging();
 	capabilities& get_driver_caps();
+	void init_offline_driver_caps();
 	bool is_primitive_native(rsx::primitive_type in);
 	GLenum draw_mode(rsx::primitive_type in);
 
@@ -434,6 +434,7 @@ namespace rsx
 				f32 spu_usage{0};
 				f32 rsx_usage{0};
 				u32 rsx_load{0};
+				f32 draw_time{0};
 
 				const auto rsx_thread = g_fxo->get<rsx::thread>();
 
@@ -447,6 +448,7 @@ namespace rsx
 					frametime = m_force_update ? 0.f : std::max(0.f, static_cast<float>(elapsed_update / m_frames));
 
 					rsx_load = rsx_thread->get_load();
+					draw_time = rsx_thread->get_draw_time();
 
 					total_threads = CPUStats::get_thread_count();
 
@@ -525,8 +527,9 @@ namespace rsx
 					                         " RSX   : %04.1f %% ( 1)\n"
 					                         " Total : %04.1f %% (%2u)\n\n"
 					                         "%s\n"
-					                         " RSX   : %02u %%",
-					    fps, frametime, std::string(title1_high.size(), ' '), ppu_usage, ppus, spu_usage, spus, rsx_usage, cpu_usage, total_threads, std::string(title2.size(), ' '), rsx_load);
+					                         " RSX   : %02u %%\n"
+					                         " Draw  : %04.1f us",
+					    fps, frametime, std::string(title1_high.size(), ' '), ppu_usage, ppus, spu_usage, spus, rsx_usage, cpu_usage, total_threads, std::string(title2.size(), ' '), rsx_load, draw_time);
 					break;
 				}
 				}
@@ -14,7 +14,7 @@ namespace rsx
 			// minimal - fps
 			// low - fps, total cpu usage
 			// medium - fps, detailed cpu usage
-			// high - fps, frametime, detailed cpu usage, thread number, rsx load
+			// high - fps, frametime, detailed cpu usage, thread number, rsx load, cpu time per draw
 			detail_level m_detail{};
 
 			screen_quadrant m_quadrant{};
@@ -3,6 +3,7 @@
 #include "RSXFIFO.h"
 #include "RSXThread.h"
 #include "Capture/rsx_capture.h"
+#include "Common/BufferUtils.h"
 
 namespace rsx
 {
@@ -65,23 +66,48 @@ namespace rsx
 			// Update ctrl registers
 			m_ctrl->get.release(m_internal_get = get);
 			m_remaining_commands = 0;
+			clear_prefetch();
 
 			// Clear memwatch spinner
 			m_memwatch_addr = 0;
 		}
 
+		bool FIFO_control::prefetch_args()
+		{
+			// Fetch as many arguments of the current packet as the PUT pointer allows at once
+			const u32 put = read_put<false>();
+
+			if (put == m_internal_get)
+			{
+				return false;
+			}
+
+			u32 count = std::min<u32>(m_remaining_commands, ::size32(m_prefetch_args));
+
+			if (put > m_internal_get)
+			{
+				count = std::min<u32>(count, (put - m_internal_get) / 4);
+			}
+
+			stream_data_to_memory_swapped_u32<true>(m_prefetch_args.data(), vm::base(m_args_ptr + 4), count, 4);
+
+			m_prefetch_pos = 0;
+			m_prefetch_count = count;
+			return true;
+		}
+
 		bool FIFO_control::read_unsafe(register_pair& data)
 		{
 			// Fast read with no processing, only safe inside a PACKET_BEGIN+count block
 			if (m_remaining_commands &&
-				m_internal_get != read_put<false>())
+				(m_prefetch_pos < m_prefetch_count || prefetch_args()))
 			{
 				m_command_reg += m_command_inc;
 				m_args_ptr += 4;
 				m_remaining_commands--;
 				m_internal_get += 4;
 
-				data.set(m_command_reg, vm::read32(m_args_ptr));
+				data.set(m_command_reg, m_prefetch_args[m_prefetch_pos++]);
 				return true;
 			}
 
@@ -99,17 +125,28 @@ namespace rsx
 				m_remaining_commands -= count;
 				m_internal_get += 4 * count;
 
+				if (m_prefetch_count - m_prefetch_pos >= count)
+				{
+					m_prefetch_pos += count;
+				}
+				else
+				{
+					clear_prefetch();
+				}
+
 				return true;
 			}
 
 			m_internal_get += 4 * m_remaining_commands;
 			m_remaining_commands = 0;
+			clear_prefetch();
 			return false;
 		}
 
 		void FIFO_control::abort()
 		{
 			m_remaining_commands = 0;
+			clear_prefetch();
 		}
 
 		void FIFO_control::read(register_pair& data)
@@ -202,6 +239,7 @@ namespace rsx
 				m_command_reg = m_cmd & 0xfffc;
 				m_command_inc = ((m_cmd & RSX_METHOD_NON_INCREMENT_CMD_MASK) == RSX_METHOD_NON_INCREMENT_CMD) ? 0 : 4;
 				m_remaining_commands = count - 1;
+				clear_prefetch();
 			}
 
 			inc_get(true); // Wait for data block to become available
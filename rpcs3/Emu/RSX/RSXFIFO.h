@@ -125,6 +125,14 @@ namespace rsx
 			u32 m_args_ptr = 0;
 			u32 m_cmd = ~0u;
 
+			// Arguments of the current packet fetched ahead in one go (byte-swapped)
+			std::array<u32, 64> m_prefetch_args;
+			u32 m_prefetch_pos = 0;
+			u32 m_prefetch_count = 0;
+
+			bool prefetch_args();
+			void clear_prefetch() { m_prefetch_pos = m_prefetch_count = 0; }
+
 		public:
 			FIFO_control(rsx::thread* pctrl);
 			~FIFO_control() = default;
@@ -245,6 +245,9 @@ struct RSXFragmentProgram
 
 	bool valid;
 
+	// Cached ucode hash, 0 if not computed yet
+	u64 ucode_hash = 0;
+
 	rsx::texture_dimension_extended get_texture_dimension(u8 id) const
 	{
 		return rsx::texture_dimension_extended{static_cast<u8>((texture_dimensions >> (id * 2)) & 0x3)};
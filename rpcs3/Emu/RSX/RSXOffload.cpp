@@ -31,7 +31,7 @@ namespace rsx
 
 			if (g_cfg.core.thread_scheduler_enabled)
 			{
-				thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+				thread_ctrl::set_thread_affinity(thread_class::rsx);
 			}
 
 			while (thread_ctrl::state() != thread_state::aborting)
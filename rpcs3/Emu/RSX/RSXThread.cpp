@@ -369,6 +369,9 @@ namespace rsx
 			m_graphics_state |= rsx::pipeline_state::fragment_texture_state_dirty;
 		}
 
+		// Sample draw call CPU time for the performance overlay
+		performance_counters.draw_begin_timestamp = g_cfg.video.perf_overlay.perf_overlay_enabled ? get_system_time() : 0;
+
 		in_begin_end = true;
 	}
 
@@ -410,6 +413,13 @@ namespace rsx
 		in_begin_end = false;
 		m_frame_stats.draw_calls++;
 
+		if (performance_counters.draw_begin_timestamp)
+		{
+			performance_counters.draw_time += get_system_time() - performance_counters.draw_begin_timestamp;
+			performance_counters.draw_calls++;
+			performance_counters.draw_begin_timestamp = 0;
+		}
+
 		method_registers.current_draw_clause.post_execute_cleanup();
 
 		m_graphics_state |= rsx::pipeline_state::framebuffer_reads_dirty;
@@ -574,7 +584,7 @@ namespace rsx
 
 			if (g_cfg.core.thread_scheduler_enabled)
 			{
-				thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+				thread_ctrl::set_thread_affinity(thread_class::rsx);
 			}
 
 			while (!Emu.IsStopped() && !m_rsx_thread_exiting)
@@ -600,7 +610,7 @@ namespace rsx
 
 		if (g_cfg.core.thread_scheduler_enabled)
 		{
-			thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+			thread_ctrl::set_thread_affinity(thread_class::rsx);
 		}
 
 		// Round to nearest to deal with forward/reverse scaling
@@ -1376,12 +1386,18 @@ namespace rsx
 		current_vertex_program.jump_table.clear();
 		current_vertex_program.texture_dimensions = 0;
 
-		current_vp_metadata = program_hash_util::vertex_program_utils::analyse_vertex_program
-		(
-			method_registers.transform_program.data(),  // Input raw block
-			transform_program_start,                    // Address of entry point
-			current_vertex_program                      // [out] Program object
-		);
+		if (!m_vp_analysis_cache.lookup(method_registers.transform_program.data(), transform_program_start, m_transform_program_generation, current_vp_metadata, current_vertex_program))
+		{
+			current_vp_metadata = program_hash_util::vertex_program_utils::analyse_vertex_program
+			(
+				method_registers.transform_program.data(),  // Input raw block
+				transform_program_start,                    // Address of entry point
+				current_vertex_program                      // [out] Program object
+			);
+
+			current_vertex_program.ucode_hash = program_hash_util::vertex_program_utils::get_vertex_program_ucode_hash(current_vertex_program);
+			m_vp_analysis_cache.store(method_registers.transform_program.data(), transform_program_start, m_transform_program_generation, current_vp_metadata, current_vertex_program);
+		}
 
 		if (!skip_textures && current_vp_metadata.referenced_textures_mask != 0)
 		{
@@ -1440,9 +1456,29 @@ namespace rsx
 		}
 	}
 
-	void thread::analyse_inputs_interleaved(vertex_input_layout& result) const
+	void thread::analyse_inputs_interleaved(vertex_input_layout& result)
 	{
 		const rsx_state& state = rsx::method_registers;
+
+		// Inlined arrays and immediate draws source their inputs from the command stream
+		const bool cacheable = state.current_draw_clause.command != rsx::draw_command::inlined_array &&
+			!(state.current_draw_clause.is_immediate_draw && state.current_draw_clause.command != rsx::draw_command::indexed);
+
+		if (cacheable && m_cached_vertex_layout == &result &&
+			!(state.dirty_state_groups & rsx::state_group::vertex_layout_state))
+		{
+			// Layout is unchanged, only the vertex base may have moved
+			for (auto &info : result.interleaved_blocks)
+			{
+				info.real_offset_address = rsx::get_address(rsx::get_vertex_offset_from_base(state.vertex_data_base_offset(), info.base_offset), info.memory_location, HERE);
+			}
+
+			return;
+		}
+
+		rsx::method_registers.dirty_state_groups &= ~rsx::state_group::vertex_layout_state;
+		m_cached_vertex_layout = cacheable ? &result : nullptr;
+
 		const u32 input_mask = state.vertex_attrib_input_mask();
 
 		result.clear();
@@ -1615,15 +1651,28 @@ namespace rsx
 		auto &result = current_fragment_program = {};
 
 		const auto [program_offset, program_location] = method_registers.shader_program_address();
+		const u32 program_address = rsx::get_address(program_offset, program_location, HERE);
+
+		result.addr = vm::base(program_address);
 
-		result.addr = vm::base(rsx::get_address(program_offset, program_location, HERE));
-		current_fp_metadata = program_hash_util::fragment_program_utils::analyse_fragment_program(result.addr);
+		const bool cached = m_fp_analysis_cache.lookup(program_address, result.addr, current_fp_metadata, result.ucode_hash);
+
+		if (!cached)
+		{
+			current_fp_metadata = program_hash_util::fragment_program_utils::analyse_fragment_program(result.addr);
+		}
 
 		result.addr = (static_cast<u8*>(result.addr) + current_fp_metadata.program_start_offset);
 		result.offset = program_offset + current_fp_metadata.program_start_offset;
 		result.ucode_length = current_fp_metadata.program_ucode_length;
 		result.total_length = result.ucode_length + current_fp_metadata.program_start_offset;
 		result.valid = true;
+
+		if (!cached)
+		{
+			result.ucode_hash = program_hash_util::fragment_program_utils::get_fragment_program_ucode_hash(result);
+			m_fp_analysis_cache.store(program_address, vm::base(program_address), current_fp_metadata, result.ucode_hash);
+		}
 		result.ctrl = rsx::method_registers.shader_control() & (CELL_GCM_SHADER_CONTROL_32_BITS_EXPORTS | CELL_GCM_SHADER_CONTROL_DEPTH_EXPORT);
 		result.texcoord_control_mask = rsx::method_registers.texcoord_control_mask();
 		result.unnormalized_coords = 0;
@@ -2583,6 +2632,20 @@ namespace rsx
 		return performance_counters.approximate_load;
 	}
 
+	f32 thread::get_draw_time()
+	{
+		// Average over the draw calls sampled since the last query
+		const u32 draw_calls = performance_counters.draw_calls.exchange(0);
+		const u64 draw_time = performance_counters.draw_time.exchange(0);
+
+		if (draw_calls)
+		{
+			performance_counters.approximate_draw_time = static_cast<f32>(draw_time) / draw_calls;
+		}
+
+		return performance_counters.approximate_draw_time;
+	}
+
 	void thread::on_frame_end(u32 buffer, bool forced)
 	{
 		// Marks the end of a frame scope GPU-side
@@ -606,6 +606,9 @@ namespace rsx
 		framebuffer_layout m_framebuffer_layout;
 		bool framebuffer_status_valid = false;
 
+		// Vertex layout filled by the last cacheable input analysis
+		const vertex_input_layout* m_cached_vertex_layout = nullptr;
+
 		// Overlays
 		rsx::overlays::display_manager* m_overlay_manager = nullptr;
 
@@ -638,6 +641,10 @@ namespace rsx
 			FIFO_state state = FIFO_state::running;
 			u32 approximate_load = 0;
 			u32 sampled_frames = 0;
+			u64 draw_begin_timestamp = 0;  // Timestamp of the current draw call begin, 0 if not sampling
+			atomic_t<u64> draw_time{ 0 };  // CPU time spent in sampled draw calls in microseconds
+			atomic_t<u32> draw_calls{ 0 }; // Number of sampled draw calls
+			f32 approximate_draw_time = 0.f;
 		}
 		performance_counters;
 
@@ -690,7 +697,13 @@ namespace rsx
 		program_hash_util::fragment_program_utils::fragment_program_metadata current_fp_metadata = {};
 		program_hash_util::vertex_program_utils::vertex_program_metadata current_vp_metadata = {};
 
+		// Bumped on every transform program upload, lets cached vertex program analysis skip the ucode compare
+		u32  m_transform_program_generation = 0;
+
 	protected:
+		program_hash_util::vertex_program_analysis_cache m_vp_analysis_cache;
+		program_hash_util::fragment_program_analysis_cache m_fp_analysis_cache;
+
 		std::array<u32, 4> get_color_surface_addresses() const;
 		u32 get_zeta_surface_address() const;
 
@@ -699,8 +712,9 @@ namespace rsx
 
 		/**
 		 * Analyze vertex inputs and group all interleaved blocks
+		 * The previous result is reused if none of the vertex layout registers changed
 		 */
-		void analyse_inputs_interleaved(vertex_input_layout&) const;
+		void analyse_inputs_interleaved(vertex_input_layout&);
 
 		RSXVertexProgram current_vertex_program = {};
 		RSXFragmentProgram current_fragment_program = {};
@@ -934,6 +948,9 @@ namespace rsx
 		// Get RSX approximate load in %
 		u32 get_load();
 
+		// Get approximate CPU time spent per draw call in microseconds
+		f32 get_draw_time();
+
 		// Returns true if the current thread is the active RSX thread
 		bool is_current_thread() const { return std::this_thread::get_id() == m_rsx_thread; }
 	};
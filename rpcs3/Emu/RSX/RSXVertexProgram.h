@@ -243,6 +243,9 @@ struct RSXVertexProgram
 	std::bitset<512> instruction_mask;
 	std::set<u32> jump_table;
 
+	// Cached ucode hash, 0 if not computed yet
+	u64 ucode_hash = 0;
+
 	rsx::texture_dimension_extended get_texture_dimension(u8 id) const
 	{
 		return rsx::texture_dimension_extended{static_cast<u8>((texture_dimensions >> (id * 2)) & 0x3)};
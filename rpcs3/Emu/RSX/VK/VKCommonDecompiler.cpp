@@ -1,5 +1,8 @@
 ﻿#include "stdafx.h"
 #include "VKCommonDecompiler.h"
+#include "Utilities/File.h"
+#include "Utilities/mutex.h"
+#include "xxhash.h"
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -13,16 +16,129 @@
 #include "SPIRV/GlslangToSpv.h"
 #include "define_new_memleakdetect.h"
 #include "spirv-tools/optimizer.hpp"
+#include "spirv-tools/libspirv.hpp"
 #ifdef _MSC_VER
 #pragma warning(pop)
 #else
 #pragma GCC diagnostic pop
 #endif
 
+extern u64 get_system_time();
+
 namespace vk
 {
 	static TBuiltInResource g_default_config;
 
+	// Compiled SPIR-V cache (GLSL source hash -> module)
+	struct spirv_cache_header
+	{
+		static constexpr u32 c_magic = "SPVC"_u32;
+		static constexpr u32 c_version = 2;
+
+		le_t<u32> magic;
+		le_t<u32> version;
+		le_t<u64> source_size;
+		le_t<u64> compiler_hash;
+	};
+
+	// Everything besides the source which affects the compiled module, must match the settings in compile_glsl_to_spv
+	static u64 get_spirv_compiler_hash()
+	{
+		static const u64 s_hash = []()
+		{
+			const std::string desc = fmt::format("glslang %u (%s); spirv-tools %s; vulkan 1.0, spv 1.0; optimize size; unify-constant, merge-return, aggressive-dce",
+				glslang::GetSpirvGeneratorVersion(), glslang::GetGlslVersionString(), spvSoftwareVersionString());
+
+			return XXH64(desc.data(), desc.size(), 0);
+		}();
+
+		return s_hash;
+	}
+
+	static shared_mutex g_spirv_cache_mutex;
+	static std::string g_spirv_cache_path;
+
+	static atomic_t<u32> g_spirv_cache_hits{0};
+	static atomic_t<u32> g_spirv_cache_tmp_id{0};
+	static atomic_t<u32> g_spirv_compiled{0};
+	static atomic_t<u64> g_spirv_compile_us{0};
+
+	void set_spirv_cache_path(const std::string& path)
+	{
+		if (!path.empty() && !fs::create_path(path))
+		{
+			rsx_log.error("Failed to create SPIR-V cache directory '%s' (%s)", path, fs::g_tls_error);
+			return;
+		}
+
+		std::lock_guard lock(g_spirv_cache_mutex);
+		g_spirv_cache_path = path;
+	}
+
+	static std::string get_spirv_cache_file(const std::string& source, program_domain domain)
+	{
+		reader_lock lock(g_spirv_cache_mutex);
+
+		if (g_spirv_cache_path.empty())
+		{
+			return {};
+		}
+
+		return fmt::format("%s%016llx.spv", g_spirv_cache_path, XXH64(source.data(), source.size(), get_spirv_compiler_hash() + domain));
+	}
+
+	static bool load_cached_spirv(const std::string& path, const std::string& source, std::vector<u32>& spv)
+	{
+		fs::file file(path);
+
+		if (!file || file.size() <= sizeof(spirv_cache_header) || (file.size() - sizeof(spirv_cache_header)) % sizeof(u32))
+		{
+			return false;
+		}
+
+		spirv_cache_header header;
+
+		if (!file.read(header) || header.magic != spirv_cache_header::c_magic || header.version != spirv_cache_header::c_version || header.source_size != source.size() ||
+			header.compiler_hash != get_spirv_compiler_hash())
+		{
+			return false;
+		}
+
+		spv.resize((file.size() - sizeof(spirv_cache_header)) / sizeof(u32));
+
+		if (file.read(spv.data(), spv.size() * sizeof(u32)) != spv.size() * sizeof(u32))
+		{
+			spv.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	static void store_cached_spirv(const std::string& path, const std::string& source, const std::vector<u32>& spv)
+	{
+		// Write to a temporary file unique to this write first, so that concurrent writers and stale files don't interfere
+		const std::string tmp = fmt::format("%s.%u.tmp", path, g_spirv_cache_tmp_id++);
+
+		if (fs::file file{tmp, fs::rewrite})
+		{
+			spirv_cache_header header;
+			header.magic = spirv_cache_header::c_magic;
+			header.version = spirv_cache_header::c_version;
+			header.source_size = source.size();
+			header.compiler_hash = get_spirv_compiler_hash();
+
+			file.write(header);
+			file.write(spv);
+			file.close();
+
+			if (!fs::rename(tmp, path, true))
+			{
+				fs::remove_file(tmp);
+			}
+		}
+	}
+
 	void init_default_resources(TBuiltInResource &rsc)
 	{
 		rsc.maxLights = 32;
@@ -155,6 +271,16 @@ namespace vk
 
 	bool compile_glsl_to_spv(std::string& shader, program_domain domain, std::vector<u32>& spv)
 	{
+		const std::string cache_file = get_spirv_cache_file(shader, domain);
+
+		if (!cache_file.empty() && load_cached_spirv(cache_file, shader, spv))
+		{
+			g_spirv_cache_hits++;
+			return true;
+		}
+
+		const u64 start = get_system_time();
+
 		EShLanguage lang = (domain == glsl_fragment_program) ? EShLangFragment :
 			(domain == glsl_vertex_program)? EShLangVertex : EShLangCompute;
 
@@ -188,6 +314,14 @@ namespace vk
 				optimizer.RegisterPass(spvtools::CreateMergeReturnPass());        // Huge savings in vertex interpreter and likely normal vertex shaders
 				optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());      // Remove dead code
 				optimizer.Run(spv.data(), spv.size(), &spv);
+
+				g_spirv_compiled++;
+				g_spirv_compile_us += get_system_time() - start;
+
+				if (!cache_file.empty())
+				{
+					store_cached_spirv(cache_file, shader, spv);
+				}
 			}
 		}
 		else
@@ -199,6 +333,17 @@ namespace vk
 		return success;
 	}
 
+	bool validate_spirv(const std::vector<u32>& spv, std::string& error)
+	{
+		spvtools::SpirvTools tools(SPV_ENV_VULKAN_1_0);
+		tools.SetMessageConsumer([&](spv_message_level_t, const char*, const spv_position_t& position, const char* message)
+		{
+			error += fmt::format("%s (word %u)\n", message, position.index);
+		});
+
+		return tools.Validate(spv);
+	}
+
 	void initialize_compiler_context()
 	{
 		glslang::InitializeProcess();
@@ -207,6 +352,13 @@ namespace vk
 
 	void finalize_compiler_context()
 	{
+		if (const u32 compiled = g_spirv_compiled.exchange(0); compiled || g_spirv_cache_hits)
+		{
+			rsx_log.notice("SPIR-V: %u modules compiled in %u ms, %u loaded from cache", compiled, g_spirv_compile_us.exchange(0) / 1000, g_spirv_cache_hits.exchange(0));
+		}
+
+		set_spirv_cache_path({});
+
 		glslang::FinalizeProcess();
 	}
 }
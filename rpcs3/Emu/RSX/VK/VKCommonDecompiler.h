@@ -8,6 +8,12 @@ namespace vk
 	int get_varying_register_location(std::string_view varying_register_name);
 	bool compile_glsl_to_spv(std::string& shader, program_domain domain, std::vector<u32> &spv);
 
+	// Runs the SPIR-V validator on a module, messages are appended to error
+	bool validate_spirv(const std::vector<u32>& spv, std::string& error);
+
+	// Set directory used to store compiled SPIR-V modules (empty string disables it)
+	void set_spirv_cache_path(const std::string& path);
+
 	void initialize_compiler_context();
 	void finalize_compiler_context();
 }
@@ -360,7 +360,16 @@ void VKFragmentDecompilerThread::insertMainEnd(std::stringstream & OS)
 
 void VKFragmentDecompilerThread::Task()
 {
-	m_binding_table = vk::get_current_renderer()->get_pipeline_binding_table();
+	if (const auto pdev = vk::get_current_renderer())
+	{
+		m_binding_table = pdev->get_pipeline_binding_table();
+	}
+	else
+	{
+		// Offline decompilation, no device to query limits from
+		m_binding_table = vk::get_pipeline_binding_table(32u);
+	}
+
 	m_shader = Decompile();
 	vk_prog->SetInputs(inputs);
 }
@@ -372,13 +381,57 @@ VKFragmentProgram::~VKFragmentProgram()
 	Delete();
 }
 
+vk::spirv_fragment_options VKFragmentProgram::get_direct_spirv_options(const vk::pipeline_binding_table& bindings)
+{
+	vk::spirv_fragment_options options;
+	options.constants_binding = bindings.fragment_constant_buffers_bind_slot;
+	options.state_binding = bindings.fragment_state_bind_slot;
+	options.low_precision_tests = vk::get_driver_vendor() == vk::driver_vendor::NVIDIA;
+	options.emulate_coverage_tests = g_cfg.video.antialiasing_level == msaa_level::none;
+	return options;
+}
+
 void VKFragmentProgram::Decompile(const RSXFragmentProgram& prog)
 {
+	const auto pdev = vk::get_current_renderer();
+
+	if (g_cfg.video.vk.direct_spirv)
+	{
+		const auto bindings = pdev->get_pipeline_binding_table();
+
+		vk::spirv_fragment_program direct;
+		if (vk::emit_fragment_program_spirv(prog, get_direct_spirv_options(bindings), direct))
+		{
+			shader.create(::glsl::program_domain::glsl_fragment_program, std::move(direct.code));
+			FragmentConstantOffsetCache = std::move(direct.constant_offsets);
+
+			// Same descriptors as the GLSL path, all four color outputs are always written
+			vk::glsl::program_input in;
+			in.location = bindings.fragment_constant_buffers_bind_slot;
+			in.domain = glsl::glsl_fragment_program;
+			in.name = "FragmentConstantsBuffer";
+			in.type = vk::glsl::input_type_uniform_buffer;
+			uniforms.push_back(in);
+
+			in.location = bindings.fragment_state_bind_slot;
+			in.name = "FragmentStateBuffer";
+			uniforms.push_back(in);
+
+			in.location = bindings.fragment_texture_params_bind_slot;
+			in.name = "TextureParametersBuffer";
+			uniforms.push_back(in);
+
+			output_color_masks.fill(UINT32_MAX);
+			return;
+		}
+
+		rsx_log.trace("Fragment program compiled through GLSL: %s", direct.unsupported);
+	}
+
 	u32 size;
 	std::string source;
 	VKFragmentDecompilerThread decompiler(source, parr, prog, size, *this);
 
-	const auto pdev = vk::get_current_renderer();
 	if (!g_cfg.video.disable_native_float16)
 	{
 		decompiler.device_props.has_native_half_support = pdev->get_shader_types_support().allow_float16;
@@ -408,7 +461,20 @@ void VKFragmentProgram::Decompile(const RSXFragmentProgram& prog)
 void VKFragmentProgram::Compile()
 {
 	if (g_cfg.video.log_programs)
-		fs::file(fs::get_cache_dir() + "shaderlog/FragmentProgram" + std::to_string(id) + ".spirv", fs::rewrite).write(shader.get_source());
+	{
+		fs::file log(fs::get_cache_dir() + "shaderlog/FragmentProgram" + std::to_string(id) + ".spirv", fs::rewrite);
+
+		if (shader.get_source().empty())
+		{
+			// Emitted directly as SPIR-V
+			log.write(shader.get_compiled());
+		}
+		else
+		{
+			log.write(shader.get_source());
+		}
+	}
+
 	handle = shader.compile();
 }
 
@@ -4,6 +4,7 @@
 #include "Emu/RSX/RSXFragmentProgram.h"
 #include "VulkanAPI.h"
 #include "VKHelpers.h"
+#include "VKFragmentSPIRV.h"
 
 namespace vk
 {
@@ -76,6 +77,9 @@ public:
 	/** Compile the decompiled fragment shader into a format we can use with OpenGL. */
 	void Compile();
 
+	/** Options for vk::emit_fragment_program_spirv matching the state the GLSL path would use */
+	static vk::spirv_fragment_options get_direct_spirv_options(const vk::pipeline_binding_table& bindings);
+
 private:
 	/** Deletes the shader and any stored information */
 	void Delete();
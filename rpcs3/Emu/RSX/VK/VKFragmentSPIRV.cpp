@@ -0,0 +1,1317 @@
+#include "stdafx.h"
+#include "VKFragmentSPIRV.h"
+#include "VKCommonDecompiler.h"
+#include "Emu/RSX/RSXFragmentProgram.h"
+#include "Emu/RSX/gcm_enums.h"
+
+#include <algorithm>
+#include <map>
+
+namespace vk
+{
+	namespace
+	{
+		// Subset of SPIR-V 1.0 used by the emitter
+		enum spv_op : u32
+		{
+			OpName = 5,
+			OpMemberName = 6,
+			OpExtInstImport = 11,
+			OpExtInst = 12,
+			OpMemoryModel = 14,
+			OpEntryPoint = 15,
+			OpExecutionMode = 16,
+			OpCapability = 17,
+			OpTypeVoid = 19,
+			OpTypeBool = 20,
+			OpTypeInt = 21,
+			OpTypeFloat = 22,
+			OpTypeVector = 23,
+			OpTypeStruct = 30,
+			OpTypePointer = 32,
+			OpTypeFunction = 33,
+			OpConstantTrue = 41,
+			OpConstantFalse = 42,
+			OpConstant = 43,
+			OpConstantComposite = 44,
+			OpFunction = 54,
+			OpFunctionEnd = 56,
+			OpVariable = 59,
+			OpLoad = 61,
+			OpStore = 62,
+			OpAccessChain = 65,
+			OpDecorate = 71,
+			OpMemberDecorate = 72,
+			OpVectorShuffle = 79,
+			OpCompositeConstruct = 80,
+			OpCompositeExtract = 81,
+			OpBitcast = 124,
+			OpFNegate = 127,
+			OpFAdd = 129,
+			OpFSub = 131,
+			OpFMul = 133,
+			OpFDiv = 136,
+			OpDot = 148,
+			OpIsNan = 156,
+			OpLogicalOr = 166,
+			OpLogicalAnd = 167,
+			OpLogicalNot = 168,
+			OpSelect = 169,
+			OpIEqual = 170,
+			OpINotEqual = 171,
+			OpFOrdEqual = 180,
+			OpFUnordNotEqual = 183,
+			OpFOrdLessThan = 184,
+			OpFOrdGreaterThan = 186,
+			OpFOrdLessThanEqual = 188,
+			OpFOrdGreaterThanEqual = 190,
+			OpShiftRightLogical = 194,
+			OpBitwiseAnd = 199,
+			OpDPdx = 207,
+			OpDPdy = 208,
+			OpSelectionMerge = 247,
+			OpLabel = 248,
+			OpBranchConditional = 250,
+			OpKill = 252,
+			OpReturn = 253,
+		};
+
+		// GLSL.std.450 extended instructions
+		enum glsl_op : u32
+		{
+			GLSLstd450FAbs = 4,
+			GLSLstd450Floor = 8,
+			GLSLstd450Fract = 10,
+			GLSLstd450Sin = 13,
+			GLSLstd450Cos = 14,
+			GLSLstd450Pow = 26,
+			GLSLstd450Exp = 27,
+			GLSLstd450Log = 28,
+			GLSLstd450Exp2 = 29,
+			GLSLstd450Log2 = 30,
+			GLSLstd450Sqrt = 31,
+			GLSLstd450FMin = 37,
+			GLSLstd450FMax = 40,
+			GLSLstd450FClamp = 43,
+			GLSLstd450Fma = 50,
+			GLSLstd450Length = 66,
+			GLSLstd450Normalize = 69,
+			GLSLstd450Reflect = 71,
+		};
+
+		enum : u32
+		{
+			spv_magic = 0x07230203,
+			spv_version_1_0 = 0x00010000,
+
+			spv_capability_shader = 1,
+			spv_addressing_logical = 0,
+			spv_memory_glsl450 = 1,
+			spv_model_fragment = 4,
+			spv_mode_origin_upper_left = 7,
+			spv_mode_depth_replacing = 12,
+
+			spv_storage_uniform_constant = 0,
+			spv_storage_input = 1,
+			spv_storage_uniform = 2,
+			spv_storage_output = 3,
+			spv_storage_function = 7,
+
+			spv_decoration_block = 2,
+			spv_decoration_builtin = 11,
+			spv_decoration_location = 30,
+			spv_decoration_binding = 33,
+			spv_decoration_descriptor_set = 34,
+			spv_decoration_offset = 35,
+
+			spv_builtin_frag_coord = 15,
+			spv_builtin_frag_depth = 22,
+		};
+
+		// Thrown when the program uses a feature the emitter doesn't translate
+		struct unsupported_program
+		{
+			std::string reason;
+		};
+
+		// Minimal SPIR-V module assembler: types and constants are deduplicated, the module has a single function
+		class spirv_builder
+		{
+			std::map<std::vector<u32>, u32> m_cache;
+			u32 m_next_id = 1;
+
+		public:
+			std::vector<u32> names;
+			std::vector<u32> annotations;
+			std::vector<u32> globals;
+			std::vector<u32> body;
+			std::vector<u32> interface;
+
+			u32 make_id()
+			{
+				return m_next_id++;
+			}
+
+			u32 get_bound() const
+			{
+				return m_next_id;
+			}
+
+			static void emit(std::vector<u32>& out, u32 op, std::initializer_list<u32> args)
+			{
+				out.push_back(::size32(args) + 1 << 16 | op);
+				out.insert(out.end(), args);
+			}
+
+			static void emit(std::vector<u32>& out, u32 op, const std::vector<u32>& args)
+			{
+				out.push_back(::size32(args) + 1 << 16 | op);
+				out.insert(out.end(), args.begin(), args.end());
+			}
+
+			// Appends a nul-terminated literal string
+			static void append_string(std::vector<u32>& out, std::string_view str)
+			{
+				for (std::size_t i = 0; i <= str.size(); i += 4)
+				{
+					u32 word = 0;
+
+					for (std::size_t j = 0; j < 4 && i + j < str.size(); j++)
+					{
+						word |= u32{static_cast<u8>(str[i + j])} << (j * 8);
+					}
+
+					out.push_back(word);
+				}
+			}
+
+			void name(u32 id, std::string_view str)
+			{
+				std::vector<u32> args{id};
+				append_string(args, str);
+				emit(names, OpName, args);
+			}
+
+			void member_name(u32 id, u32 member, std::string_view str)
+			{
+				std::vector<u32> args{id, member};
+				append_string(args, str);
+				emit(names, OpMemberName, args);
+			}
+
+			void decorate(u32 id, std::initializer_list<u32> args)
+			{
+				std::vector<u32> words{id};
+				words.insert(words.end(), args);
+				emit(annotations, OpDecorate, words);
+			}
+
+			void member_decorate(u32 id, u32 member, u32 decoration, u32 value)
+			{
+				emit(annotations, OpMemberDecorate, {id, member, decoration, value});
+			}
+
+			// Declares a type (result id first)
+			u32 type(u32 op, std::initializer_list<u32> args)
+			{
+				std::vector<u32> key{op};
+				key.insert(key.end(), args);
+
+				auto [found, inserted] = m_cache.try_emplace(std::move(key), 0);
+
+				if (inserted)
+				{
+					found->second = make_id();
+
+					std::vector<u32> words{found->second};
+					words.insert(words.end(), args);
+					emit(globals, op, words);
+				}
+
+				return found->second;
+			}
+
+			// Declares a constant (result type, then result id)
+			u32 constant(u32 op, u32 type, std::initializer_list<u32> args)
+			{
+				std::vector<u32> key{op, type};
+				key.insert(key.end(), args);
+
+				auto [found, inserted] = m_cache.try_emplace(std::move(key), 0);
+
+				if (inserted)
+				{
+					found->second = make_id();
+
+					std::vector<u32> words{type, found->second};
+					words.insert(words.end(), args);
+					emit(globals, op, words);
+				}
+
+				return found->second;
+			}
+
+			u32 variable(u32 ptr_type, u32 storage)
+			{
+				const u32 id = make_id();
+				emit(globals, OpVariable, {ptr_type, id, storage});
+
+				if (storage == spv_storage_input || storage == spv_storage_output)
+				{
+					interface.push_back(id);
+				}
+
+				return id;
+			}
+
+			// Function body instruction with a result
+			u32 op(u32 op, u32 type, std::initializer_list<u32> args)
+			{
+				const u32 id = make_id();
+				body.push_back(::size32(args) + 3 << 16 | op);
+				body.push_back(type);
+				body.push_back(id);
+				body.insert(body.end(), args);
+				return id;
+			}
+
+			std::vector<u32> assemble(u32 glsl_set, u32 fn_type, u32 void_type, u32 main_id, bool depth_replacing)
+			{
+				std::vector<u32> out{spv_magic, spv_version_1_0, 0, get_bound(), 0};
+
+				emit(out, OpCapability, {spv_capability_shader});
+
+				std::vector<u32> args{glsl_set};
+				append_string(args, "GLSL.std.450");
+				emit(out, OpExtInstImport, args);
+
+				emit(out, OpMemoryModel, {spv_addressing_logical, spv_memory_glsl450});
+
+				args = {spv_model_fragment, main_id};
+				append_string(args, "main");
+				args.insert(args.end(), interface.begin(), interface.end());
+				emit(out, OpEntryPoint, args);
+
+				emit(out, OpExecutionMode, {main_id, spv_mode_origin_upper_left});
+
+				if (depth_replacing)
+				{
+					emit(out, OpExecutionMode, {main_id, spv_mode_depth_replacing});
+				}
+
+				out.insert(out.end(), names.begin(), names.end());
+				out.insert(out.end(), annotations.begin(), annotations.end());
+				out.insert(out.end(), globals.begin(), globals.end());
+
+				emit(out, OpFunction, {void_type, main_id, 0, fn_type});
+				out.insert(out.end(), body.begin(), body.end());
+				emit(out, OpFunctionEnd, {});
+				return out;
+			}
+		};
+
+		class fragment_program_emitter
+		{
+			const RSXFragmentProgram& m_prog;
+			const spirv_fragment_options& m_options;
+			spirv_fragment_program& m_out;
+			spirv_builder m_spv;
+
+			u32 m_glsl = 0;
+			u32 t_void = 0, t_bool = 0, t_float = 0, t_uint = 0;
+			u32 t_vec2 = 0, t_vec3 = 0, t_vec4 = 0, t_uvec4 = 0, t_bvec3 = 0, t_bvec4 = 0;
+
+			OPDEST dst{};
+			SRC0 src0{};
+			SRC1 src1{};
+			SRC2 src2{};
+
+			u32 m_size = 0;   // Offset of the current instruction
+			u32 m_offset = 0; // Size of the current instruction (doubled by an inline constant)
+
+			// Current value of each temp register, R0-R63 at 0-63 and H0-H63 at 64-127 (not aliased, as in the GLSL path)
+			std::array<u32, 128> m_registers{};
+			std::array<bool, 128> m_referenced{};
+
+			// Writes to the first and last 64 bits of each register block, used to detect programs without output
+			std::array<u32, 64> m_h0_writes{};
+			std::array<u32, 64> m_h1_writes{};
+
+			std::map<u32, u32> m_inputs;    // Attribute index -> loaded value
+			std::map<u32, u32> m_constants; // Ucode offset -> loaded value
+			u32 m_constants_var = 0;
+			u32 m_state_var = 0;
+
+		public:
+			fragment_program_emitter(const RSXFragmentProgram& prog, const spirv_fragment_options& options, spirv_fragment_program& out)
+				: m_prog(prog)
+				, m_options(options)
+				, m_out(out)
+			{
+			}
+
+			void emit();
+
+		private:
+			static u32 get_data(u32 d)
+			{
+				return d << 16 | d >> 16;
+			}
+
+			[[noreturn]] void unsupported(std::string reason) const
+			{
+				throw unsupported_program{fmt::format("%s (at 0x%x)", reason, m_size)};
+			}
+
+			u32 op(u32 opcode, u32 type, std::initializer_list<u32> args)
+			{
+				return m_spv.op(opcode, type, args);
+			}
+
+			u32 ext(u32 type, u32 inst, u32 a)
+			{
+				return m_spv.op(OpExtInst, type, {m_glsl, inst, a});
+			}
+
+			u32 ext(u32 type, u32 inst, u32 a, u32 b)
+			{
+				return m_spv.op(OpExtInst, type, {m_glsl, inst, a, b});
+			}
+
+			u32 ext(u32 type, u32 inst, u32 a, u32 b, u32 c)
+			{
+				return m_spv.op(OpExtInst, type, {m_glsl, inst, a, b, c});
+			}
+
+			u32 const_f32(f32 value)
+			{
+				return m_spv.constant(OpConstant, t_float, {std::bit_cast<u32>(value)});
+			}
+
+			u32 const_u32(u32 value)
+			{
+				return m_spv.constant(OpConstant, t_uint, {value});
+			}
+
+			u32 const_vec4(f32 value)
+			{
+				const u32 c = const_f32(value);
+				return m_spv.constant(OpConstantComposite, t_vec4, {c, c, c, c});
+			}
+
+			u32 const_uvec4(u32 value)
+			{
+				const u32 c = const_u32(value);
+				return m_spv.constant(OpConstantComposite, t_uvec4, {c, c, c, c});
+			}
+
+			u32 splat4(u32 type, u32 scalar)
+			{
+				return op(OpCompositeConstruct, type, {scalar, scalar, scalar, scalar});
+			}
+
+			u32 component(u32 value, u32 index)
+			{
+				return op(OpCompositeExtract, t_float, {value, index});
+			}
+
+			u32 shuffle(u32 type, u32 a, u32 b, std::initializer_list<u32> components)
+			{
+				std::vector<u32> args{type, 0, a, b};
+				args.insert(args.end(), components);
+
+				const u32 id = m_spv.make_id();
+				args[1] = id;
+				spirv_builder::emit(m_spv.body, OpVectorShuffle, args);
+				return id;
+			}
+
+			u32 swizzle(u32 value, u32 x, u32 y, u32 z, u32 w)
+			{
+				return shuffle(t_vec4, value, value, {x, y, z, w});
+			}
+
+			u32 load_member(u32 var, u32 index, u32 type)
+			{
+				const u32 ptr_type = m_spv.type(OpTypePointer, {spv_storage_uniform, type});
+				return op(OpLoad, type, {op(OpAccessChain, ptr_type, {var, const_u32(index)})});
+			}
+
+			void init_types();
+			void declare_state_buffer();
+
+			u32 precision_clamp(u32 value, f32 min, f32 max);
+			u32 clamp16(u32 value);
+			u32 clamp_value(u32 value, u32 precision);
+
+			u32 get_input();
+			u32 get_constant();
+
+			template <typename T>
+			u32 get_src(const T& src);
+
+			void set_dst(u32 value);
+			bool emit_instruction(u32 opcode);
+
+			u32 compare_alpha(u32 a, u32 b, u32 func);
+			u32 linear_to_srgb(u32 value);
+			void emit_rop();
+		};
+
+		void fragment_program_emitter::init_types()
+		{
+			m_glsl = m_spv.make_id();
+
+			t_void = m_spv.type(OpTypeVoid, {});
+			t_bool = m_spv.type(OpTypeBool, {});
+			t_float = m_spv.type(OpTypeFloat, {32});
+			t_uint = m_spv.type(OpTypeInt, {32, 0});
+			t_vec2 = m_spv.type(OpTypeVector, {t_float, 2});
+			t_vec3 = m_spv.type(OpTypeVector, {t_float, 3});
+			t_vec4 = m_spv.type(OpTypeVector, {t_float, 4});
+			t_uvec4 = m_spv.type(OpTypeVector, {t_uint, 4});
+			t_bvec3 = m_spv.type(OpTypeVector, {t_bool, 3});
+			t_bvec4 = m_spv.type(OpTypeVector, {t_bool, 4});
+		}
+
+		void fragment_program_emitter::declare_state_buffer()
+		{
+			// Must match the FragmentStateBuffer block of the GLSL path
+			static constexpr std::string_view member_names[] =
+			{
+				"fog_param0", "fog_param1", "rop_control", "alpha_ref", "reserved", "fog_mode", "wpos_scale", "wpos_bias"
+			};
+
+			const u32 block = m_spv.make_id();
+			spirv_builder::emit(m_spv.globals, OpTypeStruct, {block, t_float, t_float, t_uint, t_float, t_uint, t_uint, t_float, t_float});
+
+			m_spv.name(block, "FragmentStateBuffer");
+			m_spv.decorate(block, {spv_decoration_block});
+
+			for (u32 i = 0; i < std::size(member_names); i++)
+			{
+				m_spv.member_name(block, i, member_names[i]);
+				m_spv.member_decorate(block, i, spv_decoration_offset, i * 4);
+			}
+
+			m_state_var = m_spv.variable(m_spv.type(OpTypePointer, {spv_storage_uniform, block}), spv_storage_uniform);
+			m_spv.name(m_state_var, "");
+			m_spv.decorate(m_state_var, {spv_decoration_descriptor_set, 0});
+			m_spv.decorate(m_state_var, {spv_decoration_binding, m_options.state_binding});
+		}
+
+		u32 fragment_program_emitter::precision_clamp(u32 value, f32 min, f32 max)
+		{
+			// Treat NaNs as 0
+			const u32 nans = op(OpIsNan, t_bvec4, {value});
+			value = op(OpSelect, t_vec4, {nans, const_vec4(0.f), value});
+			return ext(t_vec4, GLSLstd450FClamp, value, const_vec4(min), const_vec4(max));
+		}
+
+		u32 fragment_program_emitter::clamp16(u32 value)
+		{
+			// Accurate float to half clamping (preserves IEEE-754 NaN and infinity)
+			const u32 exponent = const_uvec4(0x7f800000);
+			const u32 bits = op(OpBitcast, t_uvec4, {value});
+			const u32 test = op(OpIEqual, t_bvec4, {op(OpBitwiseAnd, t_uvec4, {bits, exponent}), exponent});
+			const u32 clamped = ext(t_vec4, GLSLstd450FClamp, value, const_vec4(-65504.f), const_vec4(65504.f));
+			return op(OpSelect, t_vec4, {test, value, clamped});
+		}
+
+		u32 fragment_program_emitter::clamp_value(u32 value, u32 precision)
+		{
+			switch (precision)
+			{
+			case RSX_FP_PRECISION_REAL:
+			case RSX_FP_PRECISION_UNKNOWN:
+				return value;
+			case RSX_FP_PRECISION_HALF:
+				return clamp16(value);
+			case RSX_FP_PRECISION_FIXED12:
+				return precision_clamp(value, -2.f, 2.f);
+			case RSX_FP_PRECISION_FIXED9:
+				return precision_clamp(value, -1.f, 1.f);
+			case RSX_FP_PRECISION_SATURATE:
+				return precision_clamp(value, 0.f, 1.f);
+			default:
+				rsx_log.error("Unexpected precision modifier (%d)", precision);
+				return value;
+			}
+		}
+
+		u32 fragment_program_emitter::get_input()
+		{
+			static constexpr std::string_view reg_table[] =
+			{
+				"wpos",
+				"diff_color", "spec_color",
+				"fogc",
+				"tc0", "tc1", "tc2", "tc3", "tc4", "tc5", "tc6", "tc7", "tc8", "tc9",
+				"ssa"
+			};
+
+			const u32 index = dst.src_attr_reg_num;
+
+			if (index == 0 || index == 3 || index >= 14)
+			{
+				unsupported(fmt::format("input register %u", index));
+			}
+
+			if (index <= 2 && m_prog.two_sided_lighting)
+			{
+				unsupported("two-sided lighting");
+			}
+
+			if (index >= 4 && (m_prog.texcoord_is_2d(index - 4) || m_prog.texcoord_is_point_coord(index - 4)))
+			{
+				unsupported("texcoord control mask");
+			}
+
+			auto [found, inserted] = m_inputs.try_emplace(index, 0);
+
+			if (inserted)
+			{
+				const u32 var = m_spv.variable(m_spv.type(OpTypePointer, {spv_storage_input, t_vec4}), spv_storage_input);
+				m_spv.name(var, reg_table[index]);
+				m_spv.decorate(var, {spv_decoration_location, static_cast<u32>(get_varying_register_location(reg_table[index]))});
+
+				found->second = op(OpLoad, t_vec4, {var});
+			}
+
+			return found->second;
+		}
+
+		u32 fragment_program_emitter::get_constant()
+		{
+			// Inline constants are stored after the instruction and read from FragmentConstantsBuffer, in order of first use
+			const u32 offset = m_size + 4 * 4;
+			m_offset = 2 * 4 * sizeof(u32);
+
+			auto [found, inserted] = m_constants.try_emplace(offset, 0);
+
+			if (inserted)
+			{
+				if (!m_constants_var)
+				{
+					m_constants_var = m_spv.make_id();
+				}
+
+				found->second = load_member(m_constants_var, ::size32(m_out.constant_offsets), t_vec4);
+				m_out.constant_offsets.push_back(offset);
+			}
+
+			return found->second;
+		}
+
+		template <typename T>
+		u32 fragment_program_emitter::get_src(const T& src)
+		{
+			u32 value = 0;
+			bool apply_precision_modifier = !!src1.input_prec_mod;
+
+			switch (src.reg_type)
+			{
+			case RSX_FP_REGISTER_TYPE_TEMP:
+			{
+				if (src.fp16 && src1.input_prec_mod == RSX_FP_PRECISION_HALF)
+				{
+					apply_precision_modifier = false;
+				}
+
+				const u32 index = src.tmp_reg_index + (src.fp16 ? 64 : 0);
+				m_referenced[index] = true;
+				value = m_registers[index] ? m_registers[index] : const_vec4(0.f);
+				break;
+			}
+			case RSX_FP_REGISTER_TYPE_INPUT:
+			{
+				value = get_input();
+
+				// COL0 and COL1 reads are clamped unless accessed through the index register
+				if (dst.src_attr_reg_num <= 2 && !src2.use_index_reg)
+				{
+					value = ext(t_vec4, GLSLstd450FClamp, value, const_vec4(0.f), const_vec4(1.f));
+					apply_precision_modifier = false;
+				}
+
+				break;
+			}
+			case RSX_FP_REGISTER_TYPE_CONSTANT:
+				value = get_constant();
+				apply_precision_modifier = false;
+				break;
+			default:
+				unsupported(fmt::format("source register type %u", u32{src.reg_type}));
+			}
+
+			if constexpr (!std::is_same_v<T, SRC0>)
+			{
+				// Only src0 of MAD obeys the precision modifier
+				if (apply_precision_modifier && !src.neg && dst.opcode == RSX_FP_OPCODE_MAD)
+				{
+					apply_precision_modifier = false;
+				}
+			}
+
+			if (src.swizzle_x != 0 || src.swizzle_y != 1 || src.swizzle_z != 2 || src.swizzle_w != 3)
+			{
+				value = swizzle(value, src.swizzle_x, src.swizzle_y, src.swizzle_z, src.swizzle_w);
+			}
+
+			// Same modifier order as the GLSL path
+			if (src.abs) value = ext(t_vec4, GLSLstd450FAbs, value);
+			if (apply_precision_modifier) value = clamp_value(value, src1.input_prec_mod);
+			if (src.neg) value = op(OpFNegate, t_vec4, {value});
+
+			return value;
+		}
+
+		void fragment_program_emitter::set_dst(u32 value)
+		{
+			switch (src1.scale)
+			{
+			case 0: break;
+			case 1: value = op(OpFMul, t_vec4, {value, const_vec4(2.f)}); break;
+			case 2: value = op(OpFMul, t_vec4, {value, const_vec4(4.f)}); break;
+			case 3: value = op(OpFMul, t_vec4, {value, const_vec4(8.f)}); break;
+			case 5: value = op(OpFDiv, t_vec4, {value, const_vec4(2.f)}); break;
+			case 6: value = op(OpFDiv, t_vec4, {value, const_vec4(4.f)}); break;
+			case 7: value = op(OpFDiv, t_vec4, {value, const_vec4(8.f)}); break;
+			default:
+				rsx_log.error("Bad scale: %d", u32{src1.scale});
+				break;
+			}
+
+			if (dst.no_dest)
+			{
+				return;
+			}
+
+			if (dst.exp_tex)
+			{
+				// Expand [0,1] to [-1, 1]
+				value = op(OpFMul, t_vec4, {op(OpFSub, t_vec4, {value, const_vec4(0.5f)}), const_vec4(2.f)});
+			}
+
+			if (dst.saturate)
+			{
+				value = clamp_value(value, RSX_FP_PRECISION_SATURATE);
+			}
+			else if (dst.prec)
+			{
+				switch (dst.opcode)
+				{
+				case RSX_FP_OPCODE_NRM:
+				case RSX_FP_OPCODE_MAX:
+				case RSX_FP_OPCODE_MIN:
+				case RSX_FP_OPCODE_COS:
+				case RSX_FP_OPCODE_SIN:
+				case RSX_FP_OPCODE_REFL:
+				case RSX_FP_OPCODE_FRC:
+				case RSX_FP_OPCODE_LIT:
+				case RSX_FP_OPCODE_LIF:
+				case RSX_FP_OPCODE_LG2:
+					break;
+				case RSX_FP_OPCODE_MOV:
+					if (dst.fp16 && src0.fp16 && src0.reg_type == RSX_FP_REGISTER_TYPE_TEMP)
+						break;
+					[[fallthrough]];
+				default:
+					// fp16 precision flag on f32 register is ignored
+					if (dst.prec != RSX_FP_PRECISION_HALF || dst.fp16)
+					{
+						value = clamp_value(value, dst.prec);
+					}
+
+					break;
+				}
+			}
+
+			const u32 index = dst.dest_reg + (dst.fp16 ? 64 : 0);
+			m_referenced[index] = true;
+
+			const bool full_write = (dst.mask_x && dst.mask_y && dst.mask_z && dst.mask_w) || !(dst.mask_x || dst.mask_y || dst.mask_z || dst.mask_w);
+
+			if (!full_write)
+			{
+				const u32 old = m_registers[index] ? m_registers[index] : const_vec4(0.f);
+				value = shuffle(t_vec4, old, value, {dst.mask_x ? 4u : 0u, dst.mask_y ? 5u : 1u, dst.mask_z ? 6u : 2u, dst.mask_w ? 7u : 3u});
+			}
+
+			m_registers[index] = value;
+
+			if (!dst.fp16)
+			{
+				m_h0_writes[dst.dest_reg]++;
+				m_h1_writes[dst.dest_reg]++;
+			}
+			else if (dst.dest_reg & 1)
+			{
+				m_h1_writes[dst.dest_reg >> 1]++;
+			}
+			else
+			{
+				m_h0_writes[dst.dest_reg >> 1]++;
+			}
+		}
+
+		bool fragment_program_emitter::emit_instruction(u32 opcode)
+		{
+			// Scalar ops read the first component of $0 and broadcast the result
+			const auto unary_scalar = [&](auto&& func)
+			{
+				return splat4(t_vec4, func(component(get_src(src0), 0)));
+			};
+
+			const auto compare = [&](u32 cmp)
+			{
+				const u32 a = get_src(src0);
+				const u32 b = get_src(src1);
+				return op(OpSelect, t_vec4, {op(cmp, t_bvec4, {a, b}), const_vec4(1.f), const_vec4(0.f)});
+			};
+
+			const auto dot = [&](u32 type, std::initializer_list<u32> components)
+			{
+				const u32 a = get_src(src0);
+				const u32 b = get_src(src1);
+
+				if (type == t_vec4)
+				{
+					return op(OpDot, t_float, {a, b});
+				}
+
+				return op(OpDot, t_float, {shuffle(type, a, a, components), shuffle(type, b, b, components)});
+			};
+
+			switch (opcode)
+			{
+			case RSX_FP_OPCODE_ADD: set_dst(op(OpFAdd, t_vec4, {get_src(src0), get_src(src1)})); return true;
+			case RSX_FP_OPCODE_MUL: set_dst(op(OpFMul, t_vec4, {get_src(src0), get_src(src1)})); return true;
+			case RSX_FP_OPCODE_MOV: set_dst(get_src(src0)); return true;
+			case RSX_FP_OPCODE_MIN: set_dst(ext(t_vec4, GLSLstd450FMin, get_src(src0), get_src(src1))); return true;
+			case RSX_FP_OPCODE_MAX: set_dst(ext(t_vec4, GLSLstd450FMax, get_src(src0), get_src(src1))); return true;
+			case RSX_FP_OPCODE_REFL: set_dst(ext(t_vec4, GLSLstd450Reflect, get_src(src0), get_src(src1))); return true;
+			case RSX_FP_OPCODE_FLR: set_dst(ext(t_vec4, GLSLstd450Floor, get_src(src0))); return true;
+			case RSX_FP_OPCODE_FRC: set_dst(ext(t_vec4, GLSLstd450Fract, get_src(src0))); return true;
+			case RSX_FP_OPCODE_DDX: set_dst(op(OpDPdx, t_vec4, {get_src(src0)})); return true;
+			case RSX_FP_OPCODE_DDY: set_dst(op(OpDPdy, t_vec4, {get_src(src0)})); return true;
+			case RSX_FP_OPCODE_SFL: set_dst(const_vec4(0.f)); return true;
+			case RSX_FP_OPCODE_STR: set_dst(const_vec4(1.f)); return true;
+
+			case RSX_FP_OPCODE_SEQ: set_dst(compare(OpFOrdEqual)); return true;
+			case RSX_FP_OPCODE_SGE: set_dst(compare(OpFOrdGreaterThanEqual)); return true;
+			case RSX_FP_OPCODE_SGT: set_dst(compare(OpFOrdGreaterThan)); return true;
+			case RSX_FP_OPCODE_SLE: set_dst(compare(OpFOrdLessThanEqual)); return true;
+			case RSX_FP_OPCODE_SLT: set_dst(compare(OpFOrdLessThan)); return true;
+			case RSX_FP_OPCODE_SNE: set_dst(compare(OpFUnordNotEqual)); return true;
+
+			case RSX_FP_OPCODE_DP2: set_dst(splat4(t_vec4, dot(t_vec2, {0, 1}))); return true;
+			case RSX_FP_OPCODE_DP3: set_dst(splat4(t_vec4, dot(t_vec3, {0, 1, 2}))); return true;
+			case RSX_FP_OPCODE_DP4: set_dst(splat4(t_vec4, dot(t_vec4, {}))); return true;
+			case RSX_FP_OPCODE_DP2A:
+			{
+				const u32 d = dot(t_vec2, {0, 1});
+				set_dst(splat4(t_vec4, op(OpFAdd, t_float, {d, component(get_src(src2), 0)})));
+				return true;
+			}
+			case RSX_FP_OPCODE_MAD:
+			{
+				const u32 a = get_src(src0);
+				const u32 b = get_src(src1);
+				set_dst(ext(t_vec4, GLSLstd450Fma, a, b, get_src(src2)));
+				return true;
+			}
+			case RSX_FP_OPCODE_DIV:
+			{
+				const u32 a = get_src(src0);
+				set_dst(op(OpFDiv, t_vec4, {a, splat4(t_vec4, component(get_src(src1), 0))}));
+				return true;
+			}
+			case RSX_FP_OPCODE_DIVSQ:
+			{
+				// If the numerator is 0, the result is always 0 even if the denominator is 0
+				const u32 a = get_src(src0);
+				const u32 b = ext(t_float, GLSLstd450Sqrt, ext(t_float, GLSLstd450FAbs, component(get_src(src1), 0)));
+				const u32 tmp = op(OpFDiv, t_vec4, {a, splat4(t_vec4, b)});
+				const u32 choice = op(OpFOrdGreaterThan, t_bvec4, {ext(t_vec4, GLSLstd450FAbs, a), const_vec4(0.f)});
+				set_dst(op(OpSelect, t_vec4, {choice, tmp, a}));
+				return true;
+			}
+			case RSX_FP_OPCODE_RCP:
+				set_dst(unary_scalar([&](u32 x) { return op(OpFDiv, t_float, {const_f32(1.f), x}); }));
+				return true;
+			case RSX_FP_OPCODE_RSQ:
+				// RSQ ignores the sign of the input
+				set_dst(unary_scalar([&](u32 x) { return op(OpFDiv, t_float, {const_f32(1.f), ext(t_float, GLSLstd450Sqrt, ext(t_float, GLSLstd450FAbs, x))}); }));
+				return true;
+			case RSX_FP_OPCODE_EX2: set_dst(unary_scalar([&](u32 x) { return ext(t_float, GLSLstd450Exp2, x); })); return true;
+			case RSX_FP_OPCODE_LG2: set_dst(unary_scalar([&](u32 x) { return ext(t_float, GLSLstd450Log2, x); })); return true;
+			case RSX_FP_OPCODE_COS: set_dst(unary_scalar([&](u32 x) { return ext(t_float, GLSLstd450Cos, x); })); return true;
+			case RSX_FP_OPCODE_SIN: set_dst(unary_scalar([&](u32 x) { return ext(t_float, GLSLstd450Sin, x); })); return true;
+			case RSX_FP_OPCODE_DST:
+			{
+				const u32 a = get_src(src0);
+				const u32 b = get_src(src1);
+				const u32 y = op(OpFMul, t_float, {component(a, 1), component(b, 1)});
+				set_dst(op(OpCompositeConstruct, t_vec4, {const_f32(1.f), y, component(a, 2), component(b, 3)}));
+				return true;
+			}
+			case RSX_FP_OPCODE_LIT:
+			{
+				// Same as lit_legacy
+				const u32 a = get_src(src0);
+				const u32 x = ext(t_float, GLSLstd450FMax, component(a, 0), const_f32(0.f));
+				const u32 y = ext(t_float, GLSLstd450FMax, component(a, 1), const_f32(0.f));
+				const u32 power = ext(t_float, GLSLstd450Exp, op(OpFMul, t_float, {component(a, 3), ext(t_float, GLSLstd450Log, ext(t_float, GLSLstd450FMax, y, const_f32(0.0000000001f)))}));
+				const u32 z = op(OpSelect, t_float, {op(OpFOrdGreaterThan, t_bool, {x, const_f32(0.f)}), power, const_f32(0.f)});
+				set_dst(op(OpCompositeConstruct, t_vec4, {const_f32(1.f), x, z, const_f32(1.f)}));
+				return true;
+			}
+			case RSX_FP_OPCODE_LIF:
+			{
+				const u32 a = get_src(src0);
+				const u32 y = component(a, 1);
+				const u32 power = ext(t_float, GLSLstd450Pow, const_f32(2.f), component(a, 3));
+				const u32 z = op(OpSelect, t_float, {op(OpFOrdGreaterThan, t_bool, {y, const_f32(0.f)}), power, const_f32(0.f)});
+				set_dst(op(OpCompositeConstruct, t_vec4, {const_f32(1.f), y, z, const_f32(1.f)}));
+				return true;
+			}
+			case RSX_FP_OPCODE_LRP:
+			{
+				const u32 a = get_src(src0);
+				const u32 b = get_src(src1);
+				const u32 c = get_src(src2);
+				const u32 lhs = op(OpFMul, t_vec4, {c, op(OpFSub, t_vec4, {const_vec4(1.f), a})});
+				set_dst(op(OpFAdd, t_vec4, {lhs, op(OpFMul, t_vec4, {b, a})}));
+				return true;
+			}
+			case RSX_FP_OPCODE_NRM:
+			{
+				// Zero-length vectors are returned as is
+				const u32 a = get_src(src0);
+				const u32 v = shuffle(t_vec3, a, a, {0, 1, 2});
+				const u32 positive = op(OpFOrdGreaterThan, t_bool, {ext(t_float, GLSLstd450Length, v), const_f32(0.f)});
+				const u32 n = op(OpSelect, t_vec3, {op(OpCompositeConstruct, t_bvec3, {positive, positive, positive}), ext(t_vec3, GLSLstd450Normalize, v), v});
+				set_dst(shuffle(t_vec4, n, n, {0, 1, 2, 2}));
+				return true;
+			}
+			case RSX_FP_OPCODE_BEM:
+			{
+				const u32 a = get_src(src0);
+				const u32 b = get_src(src1);
+				const u32 c = get_src(src2);
+				const u32 lhs = op(OpFAdd, t_vec4, {swizzle(a, 0, 1, 0, 1), op(OpFMul, t_vec4, {swizzle(b, 0, 0, 0, 0), swizzle(c, 0, 2, 0, 2)})});
+				set_dst(op(OpFAdd, t_vec4, {lhs, op(OpFMul, t_vec4, {swizzle(b, 1, 1, 1, 1), swizzle(c, 1, 3, 1, 3)})}));
+				return true;
+			}
+			}
+
+			return false;
+		}
+
+		u32 fragment_program_emitter::compare_alpha(u32 a, u32 b, u32 func)
+		{
+			// Same as comparison_passes(), func: never, less, equal, lequal, greater, nequal, gequal, always
+			std::array<u32, 8> results;
+			results[0] = m_spv.constant(OpConstantFalse, t_bool, {});
+			results[7] = m_spv.constant(OpConstantTrue, t_bool, {});
+
+			if (m_options.low_precision_tests)
+			{
+				const u32 eq = op(OpFOrdLessThan, t_bool, {ext(t_float, GLSLstd450FAbs, op(OpFSub, t_float, {a, b})), const_f32(0.000001f)});
+				const u32 gt = op(OpFOrdGreaterThan, t_bool, {a, b});
+				const u32 ne = op(OpLogicalNot, t_bool, {eq});
+
+				results[1] = op(OpLogicalAnd, t_bool, {ne, op(OpLogicalNot, t_bool, {gt})});
+				results[2] = eq;
+				results[3] = op(OpLogicalOr, t_bool, {eq, op(OpLogicalNot, t_bool, {gt})});
+				results[4] = op(OpLogicalAnd, t_bool, {ne, gt});
+				results[5] = ne;
+				results[6] = op(OpLogicalOr, t_bool, {eq, gt});
+			}
+			else
+			{
+				results[1] = op(OpFOrdLessThan, t_bool, {a, b});
+				results[2] = op(OpFOrdEqual, t_bool, {a, b});
+				results[3] = op(OpFOrdLessThanEqual, t_bool, {a, b});
+				results[4] = op(OpFOrdGreaterThan, t_bool, {a, b});
+				results[5] = op(OpFUnordNotEqual, t_bool, {a, b});
+				results[6] = op(OpFOrdGreaterThanEqual, t_bool, {a, b});
+			}
+
+			u32 result = results[0];
+
+			for (u32 i = 1; i < results.size(); i++)
+			{
+				result = op(OpSelect, t_bool, {op(OpIEqual, t_bool, {func, const_u32(i)}), results[i], result});
+			}
+
+			return result;
+		}
+
+		u32 fragment_program_emitter::linear_to_srgb(u32 value)
+		{
+			const u32 low = op(OpFMul, t_vec4, {value, const_vec4(12.92f)});
+			const u32 exponent = splat4(t_vec4, op(OpFDiv, t_float, {const_f32(1.f), const_f32(2.4f)}));
+			const u32 high = op(OpFSub, t_vec4, {op(OpFMul, t_vec4, {const_vec4(1.055f), ext(t_vec4, GLSLstd450Pow, value, exponent)}), const_vec4(0.055f)});
+			const u32 select = op(OpFOrdLessThan, t_bvec4, {value, const_vec4(0.0031308f)});
+			return ext(t_vec4, GLSLstd450FClamp, op(OpSelect, t_vec4, {select, low, high}), const_vec4(0.f), const_vec4(1.f));
+		}
+
+		void fragment_program_emitter::emit_rop()
+		{
+			const bool fp32_outputs = !!(m_prog.ctrl & CELL_GCM_SHADER_CONTROL_32_BITS_EXPORTS);
+			const bool depth_export = !!(m_prog.ctrl & CELL_GCM_SHADER_CONTROL_DEPTH_EXPORT);
+
+			// Output registers r0, r2, r3, r4 (h0, h4, h6, h8 for 16-bit exports)
+			const std::array<u32, 4> output_blocks = { 0, 2, 3, 4 };
+			std::array<u32, 4> outputs;
+
+			bool shader_is_valid = false;
+
+			if (depth_export)
+			{
+				shader_is_valid = m_h1_writes[1] != 0;
+			}
+
+			for (u32 n = 0; n < 4; n++)
+			{
+				const u32 index = fp32_outputs ? output_blocks[n] : output_blocks[n] * 2 + 64;
+
+				if (m_referenced[index])
+				{
+					shader_is_valid |= m_h0_writes[output_blocks[n]] != 0;
+				}
+			}
+
+			if (!shader_is_valid)
+			{
+				// Same as the GLSL path which comments out the body, the registers keep their initial value
+				rsx_log.warning("Shader does not write to any output register and will be NOPed");
+				m_registers.fill(0);
+			}
+
+			for (u32 n = 0; n < 4; n++)
+			{
+				const u32 index = fp32_outputs ? output_blocks[n] : output_blocks[n] * 2 + 64;
+				outputs[n] = m_registers[index] ? m_registers[index] : const_vec4(0.f);
+			}
+
+			const u32 rop_control = load_member(m_state_var, 2, t_uint);
+			const u32 rop_enabled = op(OpINotEqual, t_bool, {op(OpBitwiseAnd, t_uint, {rop_control, const_u32(0xff)}), const_u32(0)});
+
+			const u32 alpha_test = op(OpINotEqual, t_bool, {op(OpBitwiseAnd, t_uint, {rop_control, const_u32(0x1)}), const_u32(0)});
+			const u32 alpha_func = op(OpBitwiseAnd, t_uint, {op(OpShiftRightLogical, t_uint, {rop_control, const_u32(16)}), const_u32(0x7)});
+			const u32 alpha = component(outputs[0], 3);
+			const u32 passes = compare_alpha(alpha, load_member(m_state_var, 3, t_float), alpha_func);
+
+			u32 discard = op(OpLogicalAnd, t_bool, {alpha_test, op(OpLogicalNot, t_bool, {passes})});
+
+			if (m_options.emulate_coverage_tests)
+			{
+				// Alpha to coverage: compare alpha against _rand(gl_FragCoord)
+				const u32 frag_coord = m_spv.variable(m_spv.type(OpTypePointer, {spv_storage_input, t_vec4}), spv_storage_input);
+				m_spv.name(frag_coord, "gl_FragCoord");
+				m_spv.decorate(frag_coord, {spv_decoration_builtin, spv_builtin_frag_coord});
+
+				const u32 coord = op(OpLoad, t_vec4, {frag_coord});
+				const u32 seed = m_spv.constant(OpConstantComposite, t_vec2, {const_f32(12.9898f), const_f32(78.233f)});
+				const u32 sine = ext(t_float, GLSLstd450Sin, op(OpDot, t_float, {shuffle(t_vec2, coord, coord, {0, 1}), seed}));
+				const u32 random = ext(t_float, GLSLstd450Fract, op(OpFMul, t_float, {sine, const_f32(43758.5453f)}));
+
+				const u32 a2c_enabled = op(OpINotEqual, t_bool, {op(OpBitwiseAnd, t_uint, {rop_control, const_u32(0x10)}), const_u32(0)});
+				const u32 coverage = op(OpINotEqual, t_bool, {op(OpBitwiseAnd, t_uint, {rop_control, const_u32(0x20)}), const_u32(0)});
+				const u32 covered = op(OpLogicalAnd, t_bool, {coverage, op(OpFOrdGreaterThan, t_bool, {alpha, random})});
+
+				discard = op(OpLogicalOr, t_bool, {discard, op(OpLogicalAnd, t_bool, {a2c_enabled, op(OpLogicalNot, t_bool, {covered})})});
+			}
+
+			discard = op(OpLogicalAnd, t_bool, {rop_enabled, discard});
+
+			const u32 label_discard = m_spv.make_id();
+			const u32 label_merge = m_spv.make_id();
+
+			spirv_builder::emit(m_spv.body, OpSelectionMerge, {label_merge, 0});
+			spirv_builder::emit(m_spv.body, OpBranchConditional, {discard, label_discard, label_merge});
+			spirv_builder::emit(m_spv.body, OpLabel, {label_discard});
+			spirv_builder::emit(m_spv.body, OpKill, {});
+			spirv_builder::emit(m_spv.body, OpLabel, {label_merge});
+
+			if (!fp32_outputs)
+			{
+				// sRGB conversion of the color outputs (16-bit exports only)
+				const u32 srgb = op(OpLogicalAnd, t_bool, {rop_enabled, op(OpINotEqual, t_bool, {op(OpBitwiseAnd, t_uint, {rop_control, const_u32(0x2)}), const_u32(0)})});
+				const u32 srgb4 = op(OpCompositeConstruct, t_bvec4, {srgb, srgb, srgb, srgb});
+
+				for (u32& value : outputs)
+				{
+					const u32 converted = shuffle(t_vec4, linear_to_srgb(value), value, {0, 1, 2, 7});
+					value = op(OpSelect, t_vec4, {srgb4, converted, value});
+				}
+			}
+
+			const u32 ptr_output = m_spv.type(OpTypePointer, {spv_storage_output, t_vec4});
+
+			for (u32 n = 0; n < 4; n++)
+			{
+				const u32 var = m_spv.variable(ptr_output, spv_storage_output);
+				m_spv.name(var, fmt::format("ocol%u", n));
+				m_spv.decorate(var, {spv_decoration_location, n});
+				spirv_builder::emit(m_spv.body, OpStore, {var, outputs[n]});
+			}
+
+			if (depth_export)
+			{
+				// Depth writes are always from r1.z, clamped to [0, 1]
+				const u32 frag_depth = m_spv.variable(m_spv.type(OpTypePointer, {spv_storage_output, t_float}), spv_storage_output);
+				m_spv.name(frag_depth, "gl_FragDepth");
+				m_spv.decorate(frag_depth, {spv_decoration_builtin, spv_builtin_frag_depth});
+
+				const u32 r1 = m_registers[1] ? m_registers[1] : const_vec4(0.f);
+				spirv_builder::emit(m_spv.body, OpStore, {frag_depth, ext(t_float, GLSLstd450FClamp, component(r1, 2), const_f32(0.f), const_f32(1.f))});
+			}
+
+			spirv_builder::emit(m_spv.body, OpReturn, {});
+		}
+
+		void fragment_program_emitter::emit()
+		{
+			init_types();
+			declare_state_buffer();
+
+			const u32 main_id = m_spv.make_id();
+			m_spv.name(main_id, "main");
+			spirv_builder::emit(m_spv.body, OpLabel, {m_spv.make_id()});
+
+			auto data = static_cast<const be_t<u32>*>(m_prog.addr);
+
+			while (true)
+			{
+				dst.HEX = get_data(data[0]);
+				src0.HEX = get_data(data[1]);
+				src1.HEX = get_data(data[2]);
+				src2.HEX = get_data(data[3]);
+
+				m_offset = 4 * sizeof(u32);
+
+				const u32 opcode = dst.opcode | (src1.opcode_is_branch << 6);
+
+				switch (opcode)
+				{
+				case RSX_FP_OPCODE_NOP:
+				case RSX_FP_OPCODE_FENCT:
+				case RSX_FP_OPCODE_FENCB:
+					break;
+				default:
+				{
+					if (src1.opcode_is_branch)
+					{
+						unsupported("flow control");
+					}
+
+					if (!src0.exec_if_eq && !src0.exec_if_gr && !src0.exec_if_lt)
+					{
+						// Never executed, the sources are not decoded either
+						break;
+					}
+
+					if (!src0.exec_if_eq || !src0.exec_if_gr || !src0.exec_if_lt || dst.set_cond)
+					{
+						unsupported("condition codes");
+					}
+
+					if (!emit_instruction(opcode))
+					{
+						unsupported(fmt::format("opcode %s", opcode < std::size(rsx_fp_op_names) ? rsx_fp_op_names[opcode] : "NULL"));
+					}
+
+					break;
+				}
+				}
+
+				m_size += m_offset;
+
+				if (dst.end) break;
+
+				data += m_offset / sizeof(u32);
+			}
+
+			emit_rop();
+
+			if (m_constants_var)
+			{
+				// Declared last, once all constants are known
+				const u32 block = m_spv.make_id();
+				const std::vector<u32> members(m_out.constant_offsets.size(), t_vec4);
+
+				std::vector<u32> args{block};
+				args.insert(args.end(), members.begin(), members.end());
+				spirv_builder::emit(m_spv.globals, OpTypeStruct, args);
+
+				m_spv.name(block, "FragmentConstantsBuffer");
+				m_spv.decorate(block, {spv_decoration_block});
+
+				for (u32 i = 0; i < members.size(); i++)
+				{
+					m_spv.member_name(block, i, fmt::format("fc%u", m_out.constant_offsets[i]));
+					m_spv.member_decorate(block, i, spv_decoration_offset, i * 16);
+				}
+
+				const u32 ptr = m_spv.type(OpTypePointer, {spv_storage_uniform, block});
+				spirv_builder::emit(m_spv.globals, OpVariable, {ptr, m_constants_var, spv_storage_uniform});
+				m_spv.name(m_constants_var, "");
+				m_spv.decorate(m_constants_var, {spv_decoration_descriptor_set, 0});
+				m_spv.decorate(m_constants_var, {spv_decoration_binding, m_options.constants_binding});
+			}
+
+			const u32 fn_type = m_spv.type(OpTypeFunction, {t_void});
+			m_out.code = m_spv.assemble(m_glsl, fn_type, t_void, main_id, !!(m_prog.ctrl & CELL_GCM_SHADER_CONTROL_DEPTH_EXPORT));
+		}
+	}
+
+	bool emit_fragment_program_spirv(const RSXFragmentProgram& prog, const spirv_fragment_options& options, spirv_fragment_program& out)
+	{
+		out = {};
+
+		try
+		{
+			fragment_program_emitter(prog, options, out).emit();
+		}
+		catch (const unsupported_program& e)
+		{
+			out = {};
+			out.unsupported = e.reason;
+			return false;
+		}
+
+		return true;
+	}
+
+	std::vector<std::string> get_spirv_interface(const std::vector<u32>& spv)
+	{
+		std::vector<std::string> result;
+
+		if (spv.size() < 5 || spv[0] != spv_magic)
+		{
+			return result;
+		}
+
+		struct variable
+		{
+			u32 id;
+			u32 type;
+			u32 storage;
+		};
+
+		std::map<u32, std::string> names;
+		std::map<u32, std::map<u32, u32>> decorations;
+		std::map<u32, u32> pointee;
+		std::map<u32, u32> struct_members;
+		std::vector<variable> variables;
+
+		for (std::size_t i = 5; i < spv.size();)
+		{
+			const u32 count = spv[i] >> 16;
+			const u32 opcode = spv[i] & 0xffff;
+
+			if (!count || i + count > spv.size() || opcode == OpFunction)
+			{
+				break;
+			}
+
+			const u32* args = &spv[i + 1];
+
+			switch (opcode)
+			{
+			case OpName:
+			{
+				std::string& name = names[args[0]];
+
+				for (u32 j = 1; j < count - 1; j++)
+				{
+					for (u32 k = 0; k < 4; k++)
+					{
+						if (const char c = static_cast<char>(args[j] >> (k * 8)))
+						{
+							name += c;
+						}
+						else
+						{
+							j = count;
+							break;
+						}
+					}
+				}
+
+				break;
+			}
+			case OpDecorate:
+				decorations[args[0]][args[1]] = count > 3 ? args[2] : 0;
+				break;
+			case OpTypePointer:
+				pointee[args[0]] = args[2];
+				break;
+			case OpTypeStruct:
+				struct_members[args[0]] = count - 2;
+				break;
+			case OpVariable:
+				if (args[2] != spv_storage_function)
+				{
+					variables.push_back({args[1], args[0], args[2]});
+				}
+
+				break;
+			}
+
+			i += count;
+		}
+
+		for (const variable& var : variables)
+		{
+			const auto& dec = decorations[var.id];
+			const u32 type = pointee[var.type];
+			std::string name = names[var.id];
+
+			if (name.empty())
+			{
+				// Anonymous block instance
+				name = names[type];
+			}
+
+			const auto get = [&](u32 decoration)
+			{
+				const auto found = dec.find(decoration);
+				return found == dec.end() ? u32{umax} : found->second;
+			};
+
+			switch (var.storage)
+			{
+			case spv_storage_input:
+			case spv_storage_output:
+			{
+				const char* kind = var.storage == spv_storage_input ? "input" : "output";
+
+				if (get(spv_decoration_builtin) != umax)
+					result.push_back(fmt::format("%s %s builtin=%u", kind, name, get(spv_decoration_builtin)));
+				else
+					result.push_back(fmt::format("%s %s location=%u", kind, name, get(spv_decoration_location)));
+
+				break;
+			}
+			case spv_storage_uniform:
+			case spv_storage_uniform_constant:
+			{
+				const auto members = struct_members.find(type);
+				result.push_back(fmt::format("uniform %s set=%u binding=%u members=%u", name, get(spv_decoration_descriptor_set), get(spv_decoration_binding),
+					members == struct_members.end() ? 0 : members->second));
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+}
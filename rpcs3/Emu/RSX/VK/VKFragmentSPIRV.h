@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct RSXFragmentProgram;
+
+namespace vk
+{
+	struct spirv_fragment_options
+	{
+		u32 constants_binding = 2; // FragmentConstantsBuffer
+		u32 state_binding = 3;     // FragmentStateBuffer
+		bool low_precision_tests = false;
+		bool emulate_coverage_tests = false;
+	};
+
+	struct spirv_fragment_program
+	{
+		std::vector<u32> code;
+		std::vector<size_t> constant_offsets; // Same layout as FragmentConstantOffsetCache
+		std::string unsupported;              // Reason the program has to go through the GLSL path
+	};
+
+	// Translates RSX fragment ucode directly to a SPIR-V module with the same interface as the GLSL path.
+	// Only straight-line arithmetic programs are handled; programs using textures, flow control, condition codes,
+	// KIL or the WPOS/FOGC/SSA inputs are rejected (returns false and fills in the reason).
+	bool emit_fragment_program_spirv(const RSXFragmentProgram& prog, const spirv_fragment_options& options, spirv_fragment_program& out);
+
+	// Sorted descriptions of a module's inputs, outputs and uniform blocks (used to compare the two compilation paths)
+	std::vector<std::string> get_spirv_interface(const std::vector<u32>& spv);
+}
@@ -527,6 +527,11 @@ VKGSRender::VKGSRender() : GSRender()
 
 	m_shaders_cache = std::make_unique<vk::shader_cache>(*m_prog_buffer, "vulkan", "v1.91");
 
+	if (const std::string cache_path = Emu.PPUCache(); !cache_path.empty() && !g_cfg.video.disable_on_disk_shader_cache)
+	{
+		vk::set_spirv_cache_path(cache_path + "shaders_cache/spirv/");
+	}
+
 	open_command_buffer();
 
 	for (u32 i = 0; i < m_swapchain->get_swap_image_count(); ++i)
@@ -1475,46 +1480,61 @@ bool VKGSRender::load_program()
 	if (rsx::method_registers.cull_face_enabled())
 		properties.state.enable_cull_face(vk::get_cull_face(rsx::method_registers.cull_face_mode()));
 
-	for (uint index = 0; index < m_draw_buffers.size(); ++index)
+	const u32 attachment_count = ::size32(m_draw_buffers);
+	if ((rsx::method_registers.dirty_state_groups & rsx::state_group::blend_state) ||
+		m_cached_blend_attachment_count != attachment_count)
 	{
-		bool color_mask_b = rsx::method_registers.color_mask_b(index);
-		bool color_mask_g = rsx::method_registers.color_mask_g(index);
-		bool color_mask_r = rsx::method_registers.color_mask_r(index);
-		bool color_mask_a = rsx::method_registers.color_mask_a(index);
+		rsx::method_registers.dirty_state_groups &= ~rsx::state_group::blend_state;
+		m_cached_blend_attachment_count = attachment_count;
 
-		if (rsx::method_registers.surface_color() == rsx::surface_color_format::g8b8)
-			rsx::get_g8b8_r8g8_colormask(color_mask_r, color_mask_g, color_mask_b, color_mask_a);
+		for (uint index = 0; index < m_draw_buffers.size(); ++index)
+		{
+			bool color_mask_b = rsx::method_registers.color_mask_b(index);
+			bool color_mask_g = rsx::method_registers.color_mask_g(index);
+			bool color_mask_r = rsx::method_registers.color_mask_r(index);
+			bool color_mask_a = rsx::method_registers.color_mask_a(index);
 
-		properties.state.set_color_mask(index, color_mask_r, color_mask_g, color_mask_b, color_mask_a);
-	}
+			if (rsx::method_registers.surface_color() == rsx::surface_color_format::g8b8)
+				rsx::get_g8b8_r8g8_colormask(color_mask_r, color_mask_g, color_mask_b, color_mask_a);
 
-	bool mrt_blend_enabled[] =
-	{
-		rsx::method_registers.blend_enabled(),
-		rsx::method_registers.blend_enabled_surface_1(),
-		rsx::method_registers.blend_enabled_surface_2(),
-		rsx::method_registers.blend_enabled_surface_3()
-	};
+			properties.state.set_color_mask(index, color_mask_r, color_mask_g, color_mask_b, color_mask_a);
+		}
 
-	VkBlendFactor sfactor_rgb, sfactor_a, dfactor_rgb, dfactor_a;
-	VkBlendOp equation_rgb, equation_a;
+		bool mrt_blend_enabled[] =
+		{
+			rsx::method_registers.blend_enabled(),
+			rsx::method_registers.blend_enabled_surface_1(),
+			rsx::method_registers.blend_enabled_surface_2(),
+			rsx::method_registers.blend_enabled_surface_3()
+		};
 
-	if (mrt_blend_enabled[0] || mrt_blend_enabled[1] || mrt_blend_enabled[2] || mrt_blend_enabled[3])
-	{
-		sfactor_rgb = vk::get_blend_factor(rsx::method_registers.blend_func_sfactor_rgb());
-		sfactor_a = vk::get_blend_factor(rsx::method_registers.blend_func_sfactor_a());
-		dfactor_rgb = vk::get_blend_factor(rsx::method_registers.blend_func_dfactor_rgb());
-		dfactor_a = vk::get_blend_factor(rsx::method_registers.blend_func_dfactor_a());
-		equation_rgb = vk::get_blend_op(rsx::method_registers.blend_equation_rgb());
-		equation_a = vk::get_blend_op(rsx::method_registers.blend_equation_a());
+		VkBlendFactor sfactor_rgb, sfactor_a, dfactor_rgb, dfactor_a;
+		VkBlendOp equation_rgb, equation_a;
 
-		for (u8 idx = 0; idx < m_draw_buffers.size(); ++idx)
+		if (mrt_blend_enabled[0] || mrt_blend_enabled[1] || mrt_blend_enabled[2] || mrt_blend_enabled[3])
 		{
-			if (mrt_blend_enabled[idx])
+			sfactor_rgb = vk::get_blend_factor(rsx::method_registers.blend_func_sfactor_rgb());
+			sfactor_a = vk::get_blend_factor(rsx::method_registers.blend_func_sfactor_a());
+			dfactor_rgb = vk::get_blend_factor(rsx::method_registers.blend_func_dfactor_rgb());
+			dfactor_a = vk::get_blend_factor(rsx::method_registers.blend_func_dfactor_a());
+			equation_rgb = vk::get_blend_op(rsx::method_registers.blend_equation_rgb());
+			equation_a = vk::get_blend_op(rsx::method_registers.blend_equation_a());
+
+			for (u8 idx = 0; idx < m_draw_buffers.size(); ++idx)
 			{
-				properties.state.enable_blend(idx, sfactor_rgb, sfactor_a, dfactor_rgb, dfactor_a, equation_rgb, equation_a);
+				if (mrt_blend_enabled[idx])
+				{
+					properties.state.enable_blend(idx, sfactor_rgb, sfactor_a, dfactor_rgb, dfactor_a, equation_rgb, equation_a);
+				}
 			}
 		}
+
+		std::memcpy(m_cached_blend_state, properties.state.att_state, sizeof(m_cached_blend_state));
+	}
+	else
+	{
+		// Blend inputs are unchanged since the last pipeline evaluation
+		std::memcpy(properties.state.att_state, m_cached_blend_state, sizeof(m_cached_blend_state));
 	}
 
 	if (rsx::method_registers.stencil_test_enabled())
@@ -456,6 +456,10 @@ private:
 
 	std::vector<u8> m_draw_buffers;
 
+	// Attachment blend states, rebuilt when the blend registers or the attachment count change
+	VkPipelineColorBlendAttachmentState m_cached_blend_state[4]{};
+	u32 m_cached_blend_attachment_count = ~0u;
+
 	shared_mutex m_flush_queue_mutex;
 	vk::flush_request_task m_flush_requests;
 
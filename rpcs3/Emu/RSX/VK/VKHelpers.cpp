@@ -230,10 +230,14 @@ namespace vk
 
 	pipeline_binding_table get_pipeline_binding_table(const vk::physical_device& dev)
 	{
-		pipeline_binding_table result{};
-
 		// Need to check how many samplers are supported by the driver
 		const auto usable_samplers = std::min(dev.get_limits().maxPerStageDescriptorSampledImages, 32u);
+		return get_pipeline_binding_table(usable_samplers);
+	}
+
+	pipeline_binding_table get_pipeline_binding_table(u32 usable_samplers)
+	{
+		pipeline_binding_table result{};
 		result.vertex_textures_first_bind_slot = result.textures_first_bind_slot + usable_samplers;
 		result.total_descriptor_bindings = result.vertex_textures_first_bind_slot + 4;
 		return result;
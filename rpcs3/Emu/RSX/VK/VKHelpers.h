@@ -150,6 +150,7 @@ namespace vk
 	memory_type_mapping get_memory_mapping(const physical_device& dev);
 	gpu_formats_support get_optimal_tiling_supported_formats(const physical_device& dev);
 	pipeline_binding_table get_pipeline_binding_table(const physical_device& dev);
+	pipeline_binding_table get_pipeline_binding_table(u32 usable_samplers);
 
 	// Sync helpers around vkQueueSubmit
 	void acquire_global_submit_lock();
@@ -3560,11 +3561,19 @@ public:
 				m_source = source;
 			}
 
+			// Module already in SPIR-V form, compile() only creates the shader module
+			void create(::glsl::program_domain domain, std::vector<u32>&& spirv)
+			{
+				type = domain;
+				m_source.clear();
+				m_compiled = std::move(spirv);
+			}
+
 			VkShaderModule compile()
 			{
 				verify(HERE), m_handle == VK_NULL_HANDLE;
 
-				if (!vk::compile_glsl_to_spv(m_source, type, m_compiled))
+				if (!m_source.empty() && !vk::compile_glsl_to_spv(m_source, type, m_compiled))
 				{
 					std::string shader_type = type == ::glsl::program_domain::glsl_vertex_program ? "vertex" :
 						type == ::glsl::program_domain::glsl_fragment_program ? "fragment" : "compute";
@@ -309,7 +309,16 @@ void VKVertexDecompilerThread::insertMainEnd(std::stringstream & OS)
 void VKVertexDecompilerThread::Task()
 {
 	m_device_props.emulate_conditional_rendering = vk::emulate_conditional_rendering();
-	m_binding_table = vk::get_current_renderer()->get_pipeline_binding_table();
+
+	if (const auto pdev = vk::get_current_renderer())
+	{
+		m_binding_table = pdev->get_pipeline_binding_table();
+	}
+	else
+	{
+		// Offline decompilation, no device to query limits from
+		m_binding_table = vk::get_pipeline_binding_table(32u);
+	}
 
 	m_shader = Decompile();
 	vk_prog->SetInputs(inputs);
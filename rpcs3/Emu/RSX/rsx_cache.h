@@ -384,37 +384,81 @@ namespace rsx
 
 
 
-	template <typename pipeline_storage_type, typename backend_storage>
-	class shaders_cache
+	// Backend independent part at the start of every cached pipeline object
+	struct pipeline_program_data
 	{
-		using unpacked_type = lf_fifo<std::tuple<pipeline_storage_type, RSXVertexProgram, RSXFragmentProgram>, 1000>; // TODO: Determine best size
+		u64 vertex_program_hash;
+		u64 fragment_program_hash;
+		u64 pipeline_storage_hash;
+
+		u32 vp_ctrl;
+		u32 vp_texture_dimensions;
+		u64 vp_instruction_mask[8];
+
+		u32 vp_base_address;
+		u32 vp_entry;
+		u16 vp_jump_table[32];
+
+		u32 fp_ctrl;
+		u32 fp_texture_dimensions;
+		u32 fp_texcoord_control;
+		u16 fp_unnormalized_coords;
+		u16 fp_height;
+		u16 fp_pixel_layout;
+		u16 fp_lighting_flags;
+		u16 fp_shadow_textures;
+		u16 fp_redirected_textures;
+		u16 fp_alphakill_mask;
+		u64 fp_zfunc_mask;
+
+		// Applies the captured state to a program loaded from the raw cache
+		void unpack_vertex_program(RSXVertexProgram& vp) const
+		{
+			vp.output_mask = vp_ctrl;
+			vp.texture_dimensions = vp_texture_dimensions;
+			vp.base_address = vp_base_address;
+			vp.entry = vp_entry;
+
+			pack_bitset<512>(vp.instruction_mask, vp_instruction_mask);
 
-		struct pipeline_data
-		{
-			u64 vertex_program_hash;
-			u64 fragment_program_hash;
-			u64 pipeline_storage_hash;
+			for (u8 index = 0; index < 32; ++index)
+			{
+				const auto address = vp_jump_table[index];
+				if (address == UINT16_MAX)
+				{
+					// End of list marker
+					break;
+				}
 
-			u32 vp_ctrl;
-			u32 vp_texture_dimensions;
-			u64 vp_instruction_mask[8];
+				vp.jump_table.emplace(address);
+			}
+		}
 
-			u32 vp_base_address;
-			u32 vp_entry;
-			u16 vp_jump_table[32];
+		void unpack_fragment_program(RSXFragmentProgram& fp) const
+		{
+			fp.ctrl = fp_ctrl;
+			fp.texture_dimensions = fp_texture_dimensions;
+			fp.texcoord_control_mask = fp_texcoord_control;
+			fp.unnormalized_coords = fp_unnormalized_coords;
+			fp.two_sided_lighting = !!(fp_lighting_flags & 0x1);
+			fp.shadow_textures = fp_shadow_textures;
+			fp.redirected_textures = fp_redirected_textures;
 
-			u32 fp_ctrl;
-			u32 fp_texture_dimensions;
-			u32 fp_texcoord_control;
-			u16 fp_unnormalized_coords;
-			u16 fp_height;
-			u16 fp_pixel_layout;
-			u16 fp_lighting_flags;
-			u16 fp_shadow_textures;
-			u16 fp_redirected_textures;
-			u16 fp_alphakill_mask;
-			u64 fp_zfunc_mask;
+			for (u8 index = 0; index < 16; ++index)
+			{
+				fp.textures_alpha_kill[index] = (fp_alphakill_mask & (1 << index))? 1: 0;
+				fp.textures_zfunc[index] = (fp_zfunc_mask >> (index << 2)) & 0xF;
+			}
+		}
+	};
 
+	template <typename pipeline_storage_type, typename backend_storage>
+	class shaders_cache
+	{
+		using unpacked_type = lf_fifo<std::tuple<pipeline_storage_type, RSXVertexProgram, RSXFragmentProgram>, 1000>; // TODO: Determine best size
+
+		struct pipeline_data : pipeline_program_data
+		{
 			pipeline_storage_type pipeline_properties;
 		};
 
@@ -703,38 +747,8 @@ namespace rsx
 			RSXFragmentProgram fp = load_fp_raw(data.fragment_program_hash);
 			pipeline_storage_type pipeline = data.pipeline_properties;
 
-			vp.output_mask = data.vp_ctrl;
-			vp.texture_dimensions = data.vp_texture_dimensions;
-			vp.base_address = data.vp_base_address;
-			vp.entry = data.vp_entry;
-
-			pack_bitset<512>(vp.instruction_mask, data.vp_instruction_mask);
-
-			for (u8 index = 0; index < 32; ++index)
-			{
-				const auto address = data.vp_jump_table[index];
-				if (address == UINT16_MAX)
-				{
-					// End of list marker
-					break;
-				}
-
-				vp.jump_table.emplace(address);
-			}
-
-			fp.ctrl = data.fp_ctrl;
-			fp.texture_dimensions = data.fp_texture_dimensions;
-			fp.texcoord_control_mask = data.fp_texcoord_control;
-			fp.unnormalized_coords = data.fp_unnormalized_coords;
-			fp.two_sided_lighting = !!(data.fp_lighting_flags & 0x1);
-			fp.shadow_textures = data.fp_shadow_textures;
-			fp.redirected_textures = data.fp_redirected_textures;
-
-			for (u8 index = 0; index < 16; ++index)
-			{
-				fp.textures_alpha_kill[index] = (data.fp_alphakill_mask & (1 << index))? 1: 0;
-				fp.textures_zfunc[index] = (data.fp_zfunc_mask >> (index << 2)) & 0xF;
-			}
+			data.unpack_vertex_program(vp);
+			data.unpack_fragment_program(fp);
 
 			return std::make_tuple(pipeline, vp, fp);
 		}
@@ -17,6 +17,9 @@ namespace rsx
 
 	std::array<rsx_method_t, 0x10000 / 4> methods{};
 
+	// State groups (rsx::state_group) invalidated by a change of each register
+	static std::array<u8, 0x10000 / 4> s_register_state_groups{};
+
 	void invalid_method(thread* rsx, u32 _reg, u32 arg)
 	{
 		//Don't throw, gather information and ignore broken/garbage commands
@@ -302,6 +305,12 @@ namespace rsx
 
 			auto& info = rsx::method_registers.register_vertex_info[attribute_index];
 
+			if (info.size != count)
+			{
+				// Enabling or disabling a register input changes the vertex layout
+				rsx::method_registers.dirty_state_groups |= rsx::state_group::vertex_layout_state;
+			}
+
 			info.type = vtype;
 			info.size = count;
 			info.frequency = 0;
@@ -488,6 +497,7 @@ namespace rsx
 					, vm::base(rsx->fifo_ctrl->get_current_arg_ptr()), rcount, 4);
 
 				rsx->m_graphics_state |= rsx::pipeline_state::vertex_program_dirty;
+				rsx->m_transform_program_generation++;
 				rsx::method_registers.transform_program_load_set(load_pos + ((rcount + index % 4) / 4));
 				rsx->fifo_ctrl->skip_methods(count - 1);
 			}
@@ -1261,27 +1271,9 @@ namespace rsx
 						}
 						else if (out_pitch != in_pitch || out_pitch != out_bpp * out_w)
 						{
-							const u32 buffer_pitch = out_bpp * out_w;
-							temp2.resize(buffer_pitch * out_h);
-							std::add_pointer_t<u8> buf = temp2.data(), pixels = pixels_src;
+							temp2.resize(out_bpp * out_w * out_h);
 
-							// Read the whole buffer from source
-							for (u32 y = 0; y < out_h; ++y)
-							{
-								std::memcpy(buf, pixels, buffer_pitch);
-								pixels += in_pitch;
-								buf += buffer_pitch;
-							}
-
-							buf = temp2.data(), pixels = pixels_dst;
-
-							// Write to destination
-							for (u32 y = 0; y < out_h; ++y)
-							{
-								std::memcpy(pixels, buf, buffer_pitch);
-								pixels += out_pitch;
-								buf += buffer_pitch;
-							}
+							clip_image_may_overlap(pixels_dst, pixels_src, 0, 0, out_w, out_h, out_bpp, in_pitch, out_pitch, temp2.data());
 						}
 						else
 						{
@@ -2154,6 +2146,8 @@ namespace rsx
 			registers[NV308A_SIZE_IN] = 0x0;
 			registers[NV406E_SET_REFERENCE] = get_current_renderer()->ctrl->ref = 0xffffffff;
 		}
+
+		dirty_state_groups = state_group::all_state_groups;
 	}
 
 	void rsx_state::reset()
@@ -2560,12 +2554,19 @@ namespace rsx
 		registers[0xc180 / 4] = 0x66604200;
 
 		registers[NV406E_SEMAPHORE_OFFSET] = 0x10;
+
+		dirty_state_groups = state_group::all_state_groups;
 	}
 
 	void rsx_state::decode(u32 reg, u32 value)
 	{
 		// Store new value and save previous
 		register_previous_value = std::exchange(registers[reg], value);
+
+		if (register_previous_value != value)
+		{
+			dirty_state_groups |= s_register_state_groups[reg];
+		}
 	}
 
 	bool rsx_state::test(u32 reg, u32 value) const
@@ -3139,6 +3140,25 @@ namespace rsx
 		// FIFO
 		bind<(FIFO::FIFO_DRAW_BARRIER >> 2), fifo::draw_barrier>();
 
+		// Derived state groups
+		for (u32 index = 0; index < rsx::limits::vertex_count; ++index)
+		{
+			s_register_state_groups[NV4097_SET_VERTEX_DATA_ARRAY_FORMAT + index] |= state_group::vertex_layout_state;
+			s_register_state_groups[NV4097_SET_VERTEX_DATA_ARRAY_OFFSET + index] |= state_group::vertex_layout_state;
+		}
+
+		s_register_state_groups[NV4097_SET_VERTEX_ATTRIB_INPUT_MASK] |= state_group::vertex_layout_state;
+		s_register_state_groups[NV4097_SET_FREQUENCY_DIVIDER_OPERATION] |= state_group::vertex_layout_state;
+
+		s_register_state_groups[NV4097_SET_BLEND_ENABLE] |= state_group::blend_state;
+		s_register_state_groups[NV4097_SET_BLEND_ENABLE_MRT] |= state_group::blend_state;
+		s_register_state_groups[NV4097_SET_BLEND_FUNC_SFACTOR] |= state_group::blend_state;
+		s_register_state_groups[NV4097_SET_BLEND_FUNC_DFACTOR] |= state_group::blend_state;
+		s_register_state_groups[NV4097_SET_BLEND_EQUATION] |= state_group::blend_state;
+		s_register_state_groups[NV4097_SET_COLOR_MASK] |= state_group::blend_state;
+		s_register_state_groups[NV4097_SET_COLOR_MASK_MRT] |= state_group::blend_state;
+		s_register_state_groups[NV4097_SET_SURFACE_FORMAT] |= state_group::blend_state;
+
 		return true;
 	}();
 }
@@ -42,6 +42,15 @@ namespace rsx
 		index_base_changed = (1 << 1)
 	};
 
+	// Register groups feeding derived state blocks which are cached across draw calls
+	enum state_group : u32
+	{
+		vertex_layout_state = (1 << 0), // Vertex array formats and offsets, input mask, frequency dividers
+		blend_state = (1 << 1),         // Blend enables, factors and equations, color masks, surface format
+
+		all_state_groups = vertex_layout_state | blend_state
+	};
+
 	struct barrier_t
 	{
 		u32 draw_id;
@@ -480,6 +489,9 @@ namespace rsx
 		std::array<u32, 0x10000 / 4> registers;
 		u32 register_previous_value;
 
+		// Groups whose registers changed value since the owner of the derived state last consumed them
+		u32 dirty_state_groups = state_group::all_state_groups;
+
 		template<u32 opcode>
 		using decoded_type = typename registers_decoder<opcode>::decoded_type;
 
@@ -496,6 +508,7 @@ namespace rsx
 			transform_program = in.transform_program;
 			transform_constants = in.transform_constants;
 			register_vertex_info = in.register_vertex_info;
+			dirty_state_groups = state_group::all_state_groups;
 			return *this;
 		}
 
@@ -24,10 +24,278 @@ extern "C"
 #pragma GCC diagnostic pop
 #endif
 
+#if defined(_MSC_VER)
+#define AVX2_FUNC
+#else
+#define AVX2_FUNC __attribute__((__target__("avx2")))
+#endif // _MSC_VER
+
+const bool s_use_avx2 = utils::has_avx2();
+
+namespace
+{
+	// Morton masks for a (possibly non-square) 2D surface, see rsx::convert_linear_swizzle
+	struct swizzle_masks
+	{
+		u32 x_mask;
+		u32 y_mask;
+
+		swizzle_masks(u16 width, u16 height)
+		{
+			const u32 log2width = rsx::ceil_log2(width);
+			const u32 log2height = rsx::ceil_log2(height);
+			const u32 limit_mask = 1u << (std::min(log2width, log2height) << 1);
+
+			// Bits above the interleaved region belong to whichever dimension is larger
+			x_mask = 0x55555555 | ~(limit_mask - 1);
+			y_mask = (0xAAAAAAAA & (limit_mask - 1)) | ~(limit_mask - 1);
+		}
+	};
+
+	// Copies one 4x4 tile. The swizzled tile is four 2x2 quads, each quad being two row pairs of 2 texels.
+	template <u32 N, bool input_is_swizzled>
+	void swizzle_tile_4x4(const u8* src, u8* dst, u32 pitch)
+	{
+		constexpr u32 pair_size = N * 2;
+
+		for (u32 quad = 0; quad < 4; ++quad)
+		{
+			const u32 row = (quad >> 1) * 2;
+			const u32 column = (quad & 1) * pair_size;
+
+			for (u32 n = 0; n < 2; ++n)
+			{
+				const u32 linear_offset = (row + n) * pitch + column;
+				const u32 swizzled_offset = (quad * 2 + n) * pair_size;
+
+				if constexpr (input_is_swizzled)
+				{
+					std::memcpy(dst + linear_offset, src + swizzled_offset, pair_size);
+				}
+				else
+				{
+					std::memcpy(dst + swizzled_offset, src + linear_offset, pair_size);
+				}
+			}
+		}
+	}
+
+	// The 32-bit tile permutation is its own inverse, only the addressing differs with direction
+	template <>
+	void swizzle_tile_4x4<4, false>(const u8* src, u8* dst, u32 pitch)
+	{
+		const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+		const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pitch));
+		const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pitch * 2));
+		const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pitch * 3));
+
+		const auto out = reinterpret_cast<__m128i*>(dst);
+		_mm_storeu_si128(out + 0, _mm_unpacklo_epi64(r0, r1));
+		_mm_storeu_si128(out + 1, _mm_unpackhi_epi64(r0, r1));
+		_mm_storeu_si128(out + 2, _mm_unpacklo_epi64(r2, r3));
+		_mm_storeu_si128(out + 3, _mm_unpackhi_epi64(r2, r3));
+	}
+
+	template <>
+	void swizzle_tile_4x4<4, true>(const u8* src, u8* dst, u32 pitch)
+	{
+		const auto in = reinterpret_cast<const __m128i*>(src);
+		const __m128i s0 = _mm_loadu_si128(in + 0);
+		const __m128i s1 = _mm_loadu_si128(in + 1);
+		const __m128i s2 = _mm_loadu_si128(in + 2);
+		const __m128i s3 = _mm_loadu_si128(in + 3);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(s0, s1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pitch), _mm_unpackhi_epi64(s0, s1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pitch * 2), _mm_unpacklo_epi64(s2, s3));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pitch * 3), _mm_unpackhi_epi64(s2, s3));
+	}
+
+	template <>
+	void swizzle_tile_4x4<2, false>(const u8* src, u8* dst, u32 pitch)
+	{
+		const __m128i r0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+		const __m128i r1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + pitch));
+		const __m128i r2 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + pitch * 2));
+		const __m128i r3 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + pitch * 3));
+
+		const auto out = reinterpret_cast<__m128i*>(dst);
+		_mm_storeu_si128(out + 0, _mm_unpacklo_epi32(r0, r1));
+		_mm_storeu_si128(out + 1, _mm_unpacklo_epi32(r2, r3));
+	}
+
+	template <>
+	void swizzle_tile_4x4<2, true>(const u8* src, u8* dst, u32 pitch)
+	{
+		const auto in = reinterpret_cast<const __m128i*>(src);
+		const __m128i s0 = _mm_shuffle_epi32(_mm_loadu_si128(in + 0), _MM_SHUFFLE(3, 1, 2, 0));
+		const __m128i s1 = _mm_shuffle_epi32(_mm_loadu_si128(in + 1), _MM_SHUFFLE(3, 1, 2, 0));
+
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), s0);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + pitch), _mm_unpackhi_epi64(s0, s0));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + pitch * 2), s1);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + pitch * 3), _mm_unpackhi_epi64(s1, s1));
+	}
+
+	// Two horizontally adjacent 32-bit tiles. They are contiguous in the swizzled image whenever the width is a multiple of 8.
+	template <bool input_is_swizzled>
+	AVX2_FUNC void swizzle_tile_8x4_avx2(const u8* src, u8* dst, u32 pitch)
+	{
+		if constexpr (!input_is_swizzled)
+		{
+			const __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+			const __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + pitch));
+			const __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + pitch * 2));
+			const __m256i r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + pitch * 3));
+
+			// Each lane holds the quads of one tile
+			const __m256i q0 = _mm256_unpacklo_epi64(r0, r1);
+			const __m256i q1 = _mm256_unpackhi_epi64(r0, r1);
+			const __m256i q2 = _mm256_unpacklo_epi64(r2, r3);
+			const __m256i q3 = _mm256_unpackhi_epi64(r2, r3);
+
+			const auto out = reinterpret_cast<__m256i*>(dst);
+			_mm256_storeu_si256(out + 0, _mm256_permute2x128_si256(q0, q1, 0x20));
+			_mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(q2, q3, 0x20));
+			_mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(q0, q1, 0x31));
+			_mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(q2, q3, 0x31));
+		}
+		else
+		{
+			const auto in = reinterpret_cast<const __m256i*>(src);
+			const __m256i s0 = _mm256_loadu_si256(in + 0);
+			const __m256i s1 = _mm256_loadu_si256(in + 1);
+			const __m256i s2 = _mm256_loadu_si256(in + 2);
+			const __m256i s3 = _mm256_loadu_si256(in + 3);
+
+			const __m256i q0 = _mm256_permute2x128_si256(s0, s2, 0x20);
+			const __m256i q1 = _mm256_permute2x128_si256(s0, s2, 0x31);
+			const __m256i q2 = _mm256_permute2x128_si256(s1, s3, 0x20);
+			const __m256i q3 = _mm256_permute2x128_si256(s1, s3, 0x31);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_unpacklo_epi64(q0, q1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + pitch), _mm256_unpackhi_epi64(q0, q1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + pitch * 2), _mm256_unpacklo_epi64(q2, q3));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + pitch * 3), _mm256_unpackhi_epi64(q2, q3));
+		}
+	}
+
+	// Clears the lowest 'count' bits set in mask
+	u32 drop_low_mask_bits(u32 mask, u32 count)
+	{
+		for (u32 n = 0; n < count; ++n)
+		{
+			mask &= mask - 1;
+		}
+
+		return mask;
+	}
+
+	template <u32 N, u32 block_width, bool input_is_swizzled, typename F>
+	void convert_linear_swizzle_tiled_impl(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch, F&& copy_block)
+	{
+		const swizzle_masks masks(width, height);
+
+		// Block origins have their low x/y bits clear, so they are walked with the same masked carry as the scalar path
+		const u32 x_step_mask = drop_low_mask_bits(masks.x_mask, std::countr_zero(block_width));
+		const u32 y_step_mask = drop_low_mask_bits(masks.y_mask, 2);
+
+		auto src = static_cast<const u8*>(input_pixels);
+		auto dst = static_cast<u8*>(output_pixels);
+
+		u32 offs_y = 0;
+
+		for (u32 y = 0; y < height; y += 4)
+		{
+			u32 offs_x = 0;
+
+			for (u32 x = 0; x < width; x += block_width)
+			{
+				const u32 linear_offset = y * pitch + x * N;
+				const u32 swizzled_offset = (offs_x + offs_y) * N;
+
+				if constexpr (input_is_swizzled)
+				{
+					copy_block(src + swizzled_offset, dst + linear_offset, pitch);
+				}
+				else
+				{
+					copy_block(src + linear_offset, dst + swizzled_offset, pitch);
+				}
+
+				offs_x = (offs_x - x_step_mask) & x_step_mask;
+			}
+
+			offs_y = (offs_y - y_step_mask) & y_step_mask;
+		}
+	}
+
+	template <u32 N, bool input_is_swizzled>
+	void swizzle_tiled(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch)
+	{
+		if constexpr (N == 4)
+		{
+			if (s_use_avx2 && (width & 7) == 0)
+			{
+				convert_linear_swizzle_tiled_impl<N, 8, input_is_swizzled>(input_pixels, output_pixels, width, height, pitch, [](const u8* src, u8* dst, u32 pitch)
+				{
+					swizzle_tile_8x4_avx2<input_is_swizzled>(src, dst, pitch);
+				});
+
+				return;
+			}
+		}
+
+		convert_linear_swizzle_tiled_impl<N, 4, input_is_swizzled>(input_pixels, output_pixels, width, height, pitch, [](const u8* src, u8* dst, u32 pitch)
+		{
+			swizzle_tile_4x4<N, input_is_swizzled>(src, dst, pitch);
+		});
+	}
+
+	template <u32 N>
+	void swizzle_tiled(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch, bool input_is_swizzled)
+	{
+		if (input_is_swizzled)
+		{
+			swizzle_tiled<N, true>(input_pixels, output_pixels, width, height, pitch);
+		}
+		else
+		{
+			swizzle_tiled<N, false>(input_pixels, output_pixels, width, height, pitch);
+		}
+	}
+}
+
 namespace rsx
 {
 	atomic_t<u64> g_rsx_shared_tag{ 0 };
 
+	void convert_linear_swizzle_tiled(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch, u8 texel_size, bool input_is_swizzled)
+	{
+		AUDIT(can_use_tiled_swizzle(width, height));
+
+		switch (texel_size)
+		{
+		case 1:
+			swizzle_tiled<1>(input_pixels, output_pixels, width, height, pitch, input_is_swizzled);
+			break;
+		case 2:
+			swizzle_tiled<2>(input_pixels, output_pixels, width, height, pitch, input_is_swizzled);
+			break;
+		case 4:
+			swizzle_tiled<4>(input_pixels, output_pixels, width, height, pitch, input_is_swizzled);
+			break;
+		case 8:
+			swizzle_tiled<8>(input_pixels, output_pixels, width, height, pitch, input_is_swizzled);
+			break;
+		case 16:
+			swizzle_tiled<16>(input_pixels, output_pixels, width, height, pitch, input_is_swizzled);
+			break;
+		default:
+			fmt::throw_exception("Unsupported texel size %d" HERE, texel_size);
+		}
+	}
+
 	void convert_scale_image(u8 *dst, AVPixelFormat dst_format, int dst_width, int dst_height, int dst_pitch,
 		const u8 *src, AVPixelFormat src_format, int src_width, int src_height, int src_pitch, int src_slice_h, bool bilinear)
 	{
@@ -56,6 +324,50 @@ namespace rsx
 		src += clip_y * src_pitch + clip_x * bpp;
 
 		const u32 buffer_pitch = bpp * clip_w;
+		const u8* src_end = src + (clip_h - 1) * src_pitch + buffer_pitch;
+		const u8* dst_end = dst + (clip_h - 1) * dst_pitch + buffer_pitch;
+
+		if (src_end <= dst || dst_end <= src)
+		{
+			// The clipped regions are disjoint even if the surfaces overlap
+			for (int y = 0; y < clip_h; ++y)
+			{
+				std::memcpy(dst, src, buffer_pitch);
+				src += src_pitch;
+				dst += dst_pitch;
+			}
+
+			return;
+		}
+
+		if (src_pitch == dst_pitch && static_cast<u32>(src_pitch) >= buffer_pitch)
+		{
+			// Every row moves by the same distance, walking rows away from the overlap never clobbers unread source data
+			if (dst <= src)
+			{
+				for (int y = 0; y < clip_h; ++y)
+				{
+					std::memmove(dst, src, buffer_pitch);
+					src += src_pitch;
+					dst += dst_pitch;
+				}
+			}
+			else
+			{
+				src += (clip_h - 1) * src_pitch;
+				dst += (clip_h - 1) * dst_pitch;
+
+				for (int y = 0; y < clip_h; ++y)
+				{
+					std::memmove(dst, src, buffer_pitch);
+					src -= src_pitch;
+					dst -= dst_pitch;
+				}
+			}
+
+			return;
+		}
+
 		u8* buf = buffer;
 
 		// Read the whole buffer from source
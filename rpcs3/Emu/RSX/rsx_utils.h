@@ -286,7 +286,33 @@ namespace rsx
 	template <typename Ts = u8, typename Td = Ts>
 	static void memcpy_r(void* dst, void* src, std::size_t size)
 	{
-		for (u32 i = 0; i < size; i++)
+		u32 i = 0;
+
+		if constexpr (std::is_same_v<Ts, Td> && (sizeof(Ts) == 2 || sizeof(Ts) == 4))
+		{
+			// Reverse whole vectors, the source is read backwards starting from src
+			constexpr u32 elements = 16 / sizeof(Ts);
+
+			for (; i + elements <= size; i += elements)
+			{
+				const auto src_ptr = static_cast<const Ts*>(src) - i - (elements - 1);
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_ptr));
+
+				if constexpr (sizeof(Ts) == 2)
+				{
+					v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+					v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+				}
+				else
+				{
+					v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(static_cast<Td*>(dst) + i), v);
+			}
+		}
+
+		for (; i < size; i++)
 		{
 			*(static_cast<Td*>(dst) + i) = *(static_cast<Ts*>(src) - i);
 		}
@@ -328,6 +354,18 @@ namespace rsx
 		return offset;
 	}
 
+	/**
+	 * Block based swizzle kernels. The image is walked in 4x4 texel tiles (8x4 with AVX2 for 32-bit texels),
+	 * each of which maps onto a contiguous run of the swizzled image.
+	 * Requires both dimensions to be multiples of 4. Texel size must be one of 1, 2, 4, 8 or 16 bytes.
+	 */
+	void convert_linear_swizzle_tiled(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch, u8 texel_size, bool input_is_swizzled);
+
+	static inline bool can_use_tiled_swizzle(u16 width, u16 height)
+	{
+		return width >= 4 && height >= 4 && (width & 3) == 0 && (height & 3) == 0;
+	}
+
 	/*   Note: What the ps3 calls swizzling in this case is actually z-ordering / morton ordering of pixels
 	*       - Input can be swizzled or linear, bool flag handles conversion to and from
 	*       - It will handle any width and height that are a power of 2, square or non square
@@ -337,6 +375,12 @@ namespace rsx
 	template <typename T, bool input_is_swizzled>
 	void convert_linear_swizzle(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch)
 	{
+		if (can_use_tiled_swizzle(width, height))
+		{
+			convert_linear_swizzle_tiled(input_pixels, output_pixels, width, height, pitch, sizeof(T), input_is_swizzled);
+			return;
+		}
+
 		u32 log2width = ceil_log2(width);
 		u32 log2height = ceil_log2(height);
 
@@ -429,13 +473,30 @@ namespace rsx
 		const u32 log2_h = ceil_log2(height);
 		const u32 log2_d = ceil_log2(depth);
 
+		// Each axis deposits its bits into a fixed set of positions, so the z-index is the OR of per-axis offsets
+		std::vector<u32> x_offsets(width), y_offsets(height);
+
+		for (u32 x = 0; x < width; ++x)
+		{
+			x_offsets[x] = calculate_z_index(x, 0, 0, log2_w, log2_h, log2_d);
+		}
+
+		for (u32 y = 0; y < height; ++y)
+		{
+			y_offsets[y] = calculate_z_index(0, y, 0, log2_w, log2_h, log2_d);
+		}
+
 		for (u32 z = 0; z < depth; ++z)
 		{
+			const u32 z_offset = calculate_z_index(0, 0, z, log2_w, log2_h, log2_d);
+
 			for (u32 y = 0; y < height; ++y)
 			{
+				const u32 yz_offset = y_offsets[y] | z_offset;
+
 				for (u32 x = 0; x < width; ++x)
 				{
-					*dst++ = src[calculate_z_index(x, y, z, log2_w, log2_h, log2_d)];
+					*dst++ = src[x_offsets[x] | yz_offset];
 				}
 			}
 		}
@@ -831,7 +892,7 @@ namespace rsx
 	}
 
 	template <int N>
-	void pack_bitset(std::bitset<N>& block, u64* values)
+	void pack_bitset(std::bitset<N>& block, const u64* values)
 	{
 		constexpr int count = N / 64;
 		for (int n = (count - 1); n >= 0; --n)
@@ -1702,6 +1702,13 @@ void Emulator::Stop(bool restart)
 
 	sys_log.notice("All threads have been stopped.");
 
+	if (const auto stats = thread_ctrl::get_pool_stats(); stats.created || stats.reused)
+	{
+		sys_log.notice("Host thread pool: created %u (avg %.3fus), reused %u (avg %.3fus)",
+			stats.created, stats.create_ns / 1000. / std::max<u64>(stats.created, 1),
+			stats.reused, stats.reuse_ns / 1000. / std::max<u64>(stats.reused, 1));
+	}
+
 	lv2_obj::cleanup();
 	idm::clear();
 
@@ -6,10 +6,14 @@
 #include "Utilities/mutex.h"
 #include "Utilities/StrUtil.h"
 
+#include <unordered_map>
+
 #ifdef _WIN32
 #include <Windows.h>
 #endif
 
+LOG_CHANNEL(vfs_log, "VFS");
+
 struct vfs_directory
 {
 	// Real path (empty if root or not exists)
@@ -25,6 +29,43 @@ struct vfs_manager
 
 	// VFS root
 	vfs_directory root;
+
+	// Caches are cleared when they grow beyond this size
+	static constexpr std::size_t max_cache_size = 8192;
+
+	struct path_entry
+	{
+		std::string local_path;
+		std::string out_path;
+	};
+
+	// Resolved VFS paths without out_dir (cleared on mount)
+	shared_mutex path_mutex;
+	std::unordered_map<std::string, path_entry> path_cache;
+	u64 path_gen = 0;
+
+	// Successful fs::stat results for host paths (failures aren't cached because many host writes bypass VFS)
+	shared_mutex stat_mutex;
+	std::unordered_map<std::string, fs::stat_t> stat_cache;
+	u64 stat_gen = 0;
+
+	atomic_t<u64> path_hits{0};
+	atomic_t<u64> path_misses{0};
+	atomic_t<u64> stat_hits{0};
+	atomic_t<u64> stat_misses{0};
+
+	~vfs_manager()
+	{
+		if (const u64 path_total = path_hits + path_misses)
+		{
+			vfs_log.notice("Path cache: %u hits, %u misses (%.1f%%)", path_hits, path_misses, path_hits * 100. / path_total);
+		}
+
+		if (const u64 stat_total = stat_hits + stat_misses)
+		{
+			vfs_log.notice("Stat cache: %u hits, %u misses (%.1f%%)", stat_hits, stat_misses, stat_hits * 100. / stat_total);
+		}
+	}
 };
 
 bool vfs::mount(std::string_view vpath, std::string_view path)
@@ -44,6 +85,13 @@ bool vfs::mount(std::string_view vpath, std::string_view path)
 		return false;
 	}
 
+	// Resolved paths may change
+	{
+		std::lock_guard path_lock(table->path_mutex);
+		table->path_cache.clear();
+		table->path_gen++;
+	}
+
 	for (std::vector<vfs_directory*> list{&table->root};;)
 	{
 		// Skip one or more '/'
@@ -105,10 +153,8 @@ bool vfs::mount(std::string_view vpath, std::string_view path)
 	}
 }
 
-std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
+static std::string vfs_resolve(vfs_manager* table, std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
 {
-	const auto table = g_fxo->get<vfs_manager>();
-
 	reader_lock lock(table->mutex);
 
 	// Resulting path fragments: decoded ones
@@ -277,6 +323,64 @@ std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir,
 	return std::string{result_base} + fmt::merge(escaped, "/");
 }
 
+std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
+{
+	const auto table = g_fxo->get<vfs_manager>();
+
+	if (out_dir)
+	{
+		// Mounted subdirectories are not cached
+		return vfs_resolve(table, vpath, out_dir, out_path);
+	}
+
+	std::string key{vpath};
+
+	u64 gen;
+	{
+		reader_lock lock(table->path_mutex);
+
+		if (const auto found = table->path_cache.find(key); found != table->path_cache.end())
+		{
+			table->path_hits++;
+
+			if (out_path && !found->second.out_path.empty())
+			{
+				*out_path = found->second.out_path;
+			}
+
+			return found->second.local_path;
+		}
+
+		gen = table->path_gen;
+	}
+
+	table->path_misses++;
+
+	// Always resolve out_path so that the entry can serve any caller
+	std::string path;
+	std::string result = vfs_resolve(table, vpath, nullptr, &path);
+
+	if (out_path && !path.empty())
+	{
+		*out_path = path;
+	}
+
+	std::lock_guard lock(table->path_mutex);
+
+	// Don't insert if mounted during resolution
+	if (table->path_gen == gen)
+	{
+		if (table->path_cache.size() >= vfs_manager::max_cache_size)
+		{
+			table->path_cache.clear();
+		}
+
+		table->path_cache.emplace(std::move(key), vfs_manager::path_entry{result, std::move(path)});
+	}
+
+	return result;
+}
+
 #if __cpp_char8_t >= 201811
 using char2 = char8_t;
 #else
@@ -703,19 +807,26 @@ std::string vfs::unescape(std::string_view name)
 
 bool vfs::host::rename(const std::string& from, const std::string& to, bool overwrite)
 {
+	bool result = true;
+
 	while (!fs::rename(from, to, overwrite))
 	{
 		// Try to ignore access error in order to prevent spurious failure
 		if (Emu.IsStopped() || fs::g_tls_error != fs::error::acces)
 		{
-			return false;
+			result = false;
+			break;
 		}
 	}
 
-	return true;
+	// Invalidate after the operation so that a concurrent stat can't cache the old state
+	vfs::host::invalidate(from, true);
+	vfs::host::invalidate(to, true);
+
+	return result;
 }
 
-bool vfs::host::unlink(const std::string& path, const std::string& dev_root)
+static bool host_unlink(const std::string& path, const std::string& dev_root)
 {
 #ifdef _WIN32
 	if (auto device = fs::get_virtual_device(path))
@@ -749,7 +860,16 @@ bool vfs::host::unlink(const std::string& path, const std::string& dev_root)
 #endif
 }
 
-bool vfs::host::remove_all(const std::string& path, const std::string& dev_root, bool remove_root)
+bool vfs::host::unlink(const std::string& path, const std::string& dev_root)
+{
+	const bool result = host_unlink(path, dev_root);
+
+	vfs::host::invalidate(path);
+
+	return result;
+}
+
+static bool host_remove_all(const std::string& path, const std::string& dev_root, bool remove_root)
 {
 #ifdef _WIN32
 	if (remove_root)
@@ -810,3 +930,88 @@ bool vfs::host::remove_all(const std::string& path, const std::string& dev_root,
 	return fs::remove_all(path, remove_root);
 #endif
 }
+
+bool vfs::host::remove_all(const std::string& path, const std::string& dev_root, bool remove_root)
+{
+	const bool result = host_remove_all(path, dev_root, remove_root);
+
+	vfs::host::invalidate(path, true);
+
+	return result;
+}
+
+bool vfs::host::stat(const std::string& path, fs::stat_t& info)
+{
+	const auto table = g_fxo->get<vfs_manager>();
+
+	if (!table)
+	{
+		return fs::stat(path, info);
+	}
+
+	u64 gen;
+	{
+		reader_lock lock(table->stat_mutex);
+
+		if (const auto found = table->stat_cache.find(path); found != table->stat_cache.end())
+		{
+			table->stat_hits++;
+			info = found->second;
+			return true;
+		}
+
+		gen = table->stat_gen;
+	}
+
+	table->stat_misses++;
+
+	if (!fs::stat(path, info))
+	{
+		return false;
+	}
+
+	std::lock_guard lock(table->stat_mutex);
+
+	// Don't insert if invalidated during fs::stat
+	if (table->stat_gen == gen)
+	{
+		if (table->stat_cache.size() >= vfs_manager::max_cache_size)
+		{
+			table->stat_cache.clear();
+		}
+
+		table->stat_cache.emplace(path, info);
+	}
+
+	return true;
+}
+
+void vfs::host::invalidate(const std::string& path, bool recursive)
+{
+	const auto table = g_fxo->get<vfs_manager>();
+
+	if (!table || path.empty())
+	{
+		return;
+	}
+
+	std::lock_guard lock(table->stat_mutex);
+
+	table->stat_gen++;
+	table->stat_cache.erase(path);
+
+	if (recursive)
+	{
+		for (auto it = table->stat_cache.begin(); it != table->stat_cache.end();)
+		{
+			if (it->first.size() > path.size() && it->first.compare(0, path.size(), path) == 0 && (path.back() == '/' || it->first[path.size()] == '/'))
+			{
+				it = table->stat_cache.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+	}
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Utilities/File.h"
+
 #include <vector>
 #include <string>
 #include <string_view>
@@ -29,5 +31,11 @@ namespace vfs
 
 		// Delete folder contents using rename, done atomically if remove_root is true
 		bool remove_all(const std::string& path, const std::string& dev_root, bool remove_root = true);
+
+		// Call fs::stat, successful results are cached until invalidated
+		bool stat(const std::string& path, fs::stat_t& info);
+
+		// Drop cached stat for path (and everything under it if recursive), must be called after modifying host files
+		void invalidate(const std::string& path, bool recursive = false);
 	}
 }
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <errno.h>
 #include <cstring>
 #include <cstdio>
@@ -840,6 +841,40 @@ void evdev_joystick_handler::get_mapping(const std::shared_ptr<PadDevice>& devic
 	return;
 }
 
+void evdev_joystick_handler::wait_for_input()
+{
+	// Wake up regularly anyway for rumble updates and reconnection attempts
+	constexpr int timeout_ms = 10;
+
+	std::vector<pollfd> fds;
+
+	for (const auto& binding : bindings)
+	{
+		const auto evdev_device = std::static_pointer_cast<EvdevDevice>(binding.first);
+
+		if (!evdev_device || !evdev_device->device)
+			continue;
+
+		// libevdev reads events in batches, so there may be events left without the fd being readable
+		if (libevdev_has_event_pending(evdev_device->device) > 0)
+			return;
+
+		fds.push_back({ libevdev_get_fd(evdev_device->device), POLLIN, 0 });
+	}
+
+	if (fds.empty())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+		return;
+	}
+
+	if (poll(fds.data(), fds.size(), timeout_ms) < 0 && errno != EINTR)
+	{
+		evdev_log.error("poll() failed: %s [errno %d]", strerror(errno), errno);
+		std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+	}
+}
+
 void evdev_joystick_handler::apply_pad_data(const std::shared_ptr<PadDevice>& device, const std::shared_ptr<Pad>& pad)
 {
 	auto evdev_device = std::static_pointer_cast<EvdevDevice>(device);
@@ -363,6 +363,7 @@ public:
 	void Close();
 	void get_next_button_press(const std::string& padId, const pad_callback& callback, const pad_fail_callback& fail_callback, bool get_blacklist = false, const std::vector<std::string>& buttons = {}) override;
 	void SetPadData(const std::string& padId, u32 largeMotor, u32 smallMotor, s32 r, s32 g, s32 b, bool battery_led, u32 battery_led_brightness) override;
+	void wait_for_input() override;
 
 private:
 	std::shared_ptr<EvdevDevice> get_evdev_device(const std::string& device);
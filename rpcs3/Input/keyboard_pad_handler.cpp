@@ -71,6 +71,8 @@ void keyboard_pad_handler::Key(const u32 code, bool pressed, u16 value)
 
 	for (auto pad : bindings)
 	{
+		bool is_changed = false;
+
 		for (Button& button : pad->m_buttons)
 		{
 			if (button.m_keyCode != code)
@@ -92,7 +94,9 @@ void keyboard_pad_handler::Key(const u32 code, bool pressed, u16 value)
 
 			if (update_button)
 			{
-				button.m_value = pressed ? value : 0;
+				const u16 new_value = pressed ? value : 0;
+				is_changed |= button.m_value != new_value || button.m_pressed != pressed;
+				button.m_value = new_value;
 				button.m_pressed = pressed;
 			}
 		}
@@ -119,10 +123,17 @@ void keyboard_pad_handler::Key(const u32 code, bool pressed, u16 value)
 				// to get the fastest response time possible we don't wanna use any lerp with factor 1
 				if (stick_lerp_factor >= 1.0f)
 				{
+					is_changed |= pad->m_sticks[i].m_value != m_stick_val[i];
 					pad->m_sticks[i].m_value = m_stick_val[i];
 				}
 			}
 		}
+
+		// Releasing an idle key (e.g. the periodic mouse move reset) is not new input
+		if (is_changed)
+		{
+			publish_input(pad);
+		}
 	}
 }
 
@@ -736,6 +747,8 @@ void keyboard_pad_handler::ThreadProc()
 		}
 		else
 		{
+			bool is_changed = false;
+
 			if (update_sticks)
 			{
 				for (int j = 0; j < static_cast<int>(bindings[i]->m_sticks.size()); j++)
@@ -749,6 +762,7 @@ void keyboard_pad_handler::ThreadProc()
 						const f32 v1 = static_cast<f32>(m_stick_val[j]);
 						const f32 res = get_lerped(v0, v1, stick_lerp_factor);
 
+						is_changed |= v0 != res;
 						bindings[i]->m_sticks[j].m_value = static_cast<u16>(res);
 					}
 				}
@@ -767,6 +781,7 @@ void keyboard_pad_handler::ThreadProc()
 							const f32 v1 = static_cast<f32>(button.m_actual_value);
 							const f32 res = get_lerped(v0, v1, m_analog_lerp_factor);
 
+							is_changed |= v0 != res;
 							button.m_value = static_cast<u16>(res);
 							button.m_pressed = button.m_value > 0;
 						}
@@ -780,12 +795,18 @@ void keyboard_pad_handler::ThreadProc()
 							const f32 v1 = static_cast<f32>(button.m_actual_value);
 							const f32 res = get_lerped(v0, v1, m_trigger_lerp_factor);
 
+							is_changed |= v0 != res;
 							button.m_value = static_cast<u16>(res);
 							button.m_pressed = button.m_value > 0;
 						}
 					}
 				}
 			}
+
+			if (is_changed)
+			{
+				publish_input(bindings[i]);
+			}
 		}
 	}
 
@@ -47,6 +47,11 @@ pad_thread::~pad_thread()
 	thread->join();
 
 	handlers.clear();
+
+	if (const u64 samples = m_latency_samples)
+	{
+		input_log.notice("Input latency (button and axis changes): %llu samples, average %llu us, max %llu us", samples, m_latency_total / samples, +m_latency_max);
+	}
 }
 
 void pad_thread::Init()
@@ -191,9 +196,65 @@ void pad_thread::SetIntercepted(bool intercepted)
 	}
 }
 
+void pad_thread::RecordInputLatency(u64 latency)
+{
+	m_latency_samples++;
+	m_latency_total += latency;
+	m_latency_max.fetch_op([&](u64& value)
+	{
+		value = std::max(value, latency);
+	});
+}
+
+void pad_thread::HandlerThreadFunc(std::shared_ptr<PadHandlerBase> handler)
+{
+	while (handlers_active)
+	{
+		if (!is_enabled)
+		{
+			std::this_thread::sleep_for(1ms);
+			continue;
+		}
+
+		handler->ThreadProc();
+		handler->wait_for_input();
+	}
+}
+
+void pad_thread::StartHandlerThreads()
+{
+	handlers_active = true;
+
+	for (auto& cur_pad_handler : handlers)
+	{
+		// The null handler has nothing to poll
+		if (cur_pad_handler.first == pad_handler::null)
+		{
+			continue;
+		}
+
+		handler_threads.emplace_back(&pad_thread::HandlerThreadFunc, this, cur_pad_handler.second);
+	}
+}
+
+void pad_thread::StopHandlerThreads()
+{
+	handlers_active = false;
+
+	for (auto& handler_thread : handler_threads)
+	{
+		handler_thread.join();
+	}
+
+	handler_threads.clear();
+}
+
 void pad_thread::ThreadFunc()
 {
 	active = true;
+
+	StartHandlerThreads();
+
 	while (active)
 	{
 		if (!is_enabled)
@@ -204,14 +265,15 @@ void pad_thread::ThreadFunc()
 
 		if (reset && reset.exchange(false))
 		{
+			StopHandlerThreads();
 			Init();
+			StartHandlerThreads();
 		}
 
 		u32 connected_devices = 0;
 
 		for (auto& cur_pad_handler : handlers)
 		{
-			cur_pad_handler.second->ThreadProc();
 			connected_devices += cur_pad_handler.second->connected_devices;
 		}
 
@@ -256,8 +318,11 @@ void pad_thread::ThreadFunc()
 			}
 		}
 
-		std::this_thread::sleep_for(1ms);
+		// The handlers are polled on their own threads, this only updates the global pad state
+		std::this_thread::sleep_for(10ms);
 	}
+
+	StopHandlerThreads();
 }
 
 void pad_thread::InitLddPad(u32 handle)
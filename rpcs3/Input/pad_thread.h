@@ -27,13 +27,23 @@ public:
 	s32 AddLddPad();
 	void UnregisterLddPad(u32 handle);
 
+	// Called by cellPad when the guest reads new input
+	void RecordInputLatency(u64 latency);
+
 protected:
 	void InitLddPad(u32 handle);
 	void ThreadFunc();
+	void HandlerThreadFunc(std::shared_ptr<PadHandlerBase> handler);
+	void StartHandlerThreads();
+	void StopHandlerThreads();
 
 	// List of all handlers
 	std::map<pad_handler, std::shared_ptr<PadHandlerBase>> handlers;
 
+	// Every handler is polled on its own thread so that a slow handler does not delay the others
+	std::vector<std::thread> handler_threads;
+	atomic_t<bool> handlers_active{ false };
+
 	// Used for pad_handler::keyboard
 	void *curthread;
 	void *curwindow;
@@ -47,6 +57,12 @@ protected:
 	std::shared_ptr<std::thread> thread;
 
 	u32 num_ldd_pad = 0;
+
+	// Input latency statistics (time between a handler seeing a button or axis change and the guest reading it)
+	// Updated by any thread calling cellPadGetData
+	atomic_t<u64> m_latency_samples{0};
+	atomic_t<u64> m_latency_total{0};
+	atomic_t<u64> m_latency_max{0};
 };
 
 namespace pad
@@ -132,6 +132,7 @@ bool TROPUSRLoader::Save(const std::string& filepath)
 	}
 
 	m_file.release();
+	vfs::host::invalidate(vfs::get(filepath));
 	return true;
 }
 
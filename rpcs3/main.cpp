@@ -14,6 +14,7 @@
 #include "rpcs3qt/fatal_error_dialog.h"
 
 #include "headless_application.h"
+#include "shader_decompiler_bench.h"
 #include "Utilities/sema.h"
 #ifdef _WIN32
 #include <windows.h>
@@ -167,6 +168,8 @@ const char* arg_style      = "style";
 const char* arg_stylesheet = "stylesheet";
 const char* arg_error      = "error";
 const char* arg_updating   = "updating";
+const char* arg_decompiler_bench = "decompiler-bench";
+const char* arg_decompiler_spv   = "decompiler-bench-spirv";
 
 int find_arg(std::string arg, int& argc, char* argv[])
 {
@@ -179,7 +182,7 @@ int find_arg(std::string arg, int& argc, char* argv[])
 
 QCoreApplication* createApplication(int& argc, char* argv[])
 {
-	if (find_arg(arg_headless, argc, argv))
+	if (find_arg(arg_headless, argc, argv) || find_arg(arg_decompiler_bench, argc, argv))
 		return new headless_application(argc, argv);
 
 #ifdef __linux__
@@ -407,6 +410,8 @@ int main(int argc, char** argv)
 	parser.addOption(QCommandLineOption(arg_style, "Loads a custom style.", "style", ""));
 	parser.addOption(QCommandLineOption(arg_stylesheet, "Loads a custom stylesheet.", "path", ""));
 	parser.addOption(QCommandLineOption(arg_updating, "For internal usage."));
+	parser.addOption(QCommandLineOption(arg_decompiler_bench, "Decompiles the programs of all cached pipelines in a shader cache directory and prints the timings as JSON. Can be repeated.", "path", ""));
+	parser.addOption(QCommandLineOption(arg_decompiler_spv, "Also compiles the Vulkan shaders to SPIR-V when running the decompiler benchmark, and compares fragment programs with the direct SPIR-V emitter."));
 	parser.process(app->arguments());
 
 	// Don't start up the full rpcs3 gui if we just want the version or help.
@@ -425,6 +430,20 @@ int main(int argc, char** argv)
 		return 0;
 	}
 
+	if (parser.isSet(arg_decompiler_bench))
+	{
+#ifdef _WIN32
+		if (AttachConsole(ATTACH_PARENT_PROCESS) || AllocConsole())
+			[[maybe_unused]] const auto con_out = freopen("CONOUT$", "w", stdout);
+#endif
+		std::vector<std::string> paths;
+
+		for (const auto& path : parser.values(arg_decompiler_bench))
+			paths.emplace_back(sstr(path));
+
+		return run_shader_decompiler_bench(paths, parser.isSet(arg_decompiler_spv));
+	}
+
 	if (auto gui_app = qobject_cast<gui_application*>(app.data()))
 	{
 		gui_app->setAttribute(Qt::AA_UseHighDpiPixmaps);
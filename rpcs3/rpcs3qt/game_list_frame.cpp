@@ -25,6 +25,7 @@
 #include <memory>
 #include <set>
 #include <regex>
+#include <unordered_map>
 
 #include <QtConcurrent>
 #include <QDesktopServices>
@@ -38,6 +39,101 @@
 #include <QClipboard>
 
 LOG_CHANNEL(game_list_log, "GameList");
+
+// Persistent game list index entry: PARAM.SFO data, valid while the file has the same modification time and size
+struct game_list_index_entry
+{
+	s64 mtime = 0;
+	u64 size = 0;
+	GameInfo info;
+};
+
+using game_list_index = std::unordered_map<std::string, game_list_index_entry>;
+
+static std::string get_game_list_index_path()
+{
+	return fs::get_cache_dir() + "game_list_index.yml";
+}
+
+static game_list_index load_game_list_index()
+{
+	game_list_index index;
+
+	const fs::file file(get_game_list_index_path());
+
+	if (!file)
+	{
+		return index;
+	}
+
+	auto [root, error] = yaml_load(file.to_string());
+
+	if (!error.empty())
+	{
+		game_list_log.error("Failed to load the game list index: %s", error);
+		return index;
+	}
+
+	for (const auto& pair : root)
+	{
+		const YAML::Node& node = pair.second;
+
+		if (!node.IsMap())
+		{
+			continue;
+		}
+
+		game_list_index_entry entry;
+		entry.mtime             = node["mtime"].as<s64>(0);
+		entry.size              = node["size"].as<u64>(0);
+		entry.info.serial       = node["serial"].as<std::string>("");
+		entry.info.name         = node["name"].as<std::string>("");
+		entry.info.app_ver      = node["app_ver"].as<std::string>("");
+		entry.info.version      = node["version"].as<std::string>("");
+		entry.info.category     = node["category"].as<std::string>("");
+		entry.info.fw           = node["fw"].as<std::string>("");
+		entry.info.parental_lvl = node["parental_lvl"].as<u32>(0);
+		entry.info.resolution   = node["resolution"].as<u32>(0);
+		entry.info.sound_format = node["sound_format"].as<u32>(0);
+		entry.info.bootable     = node["bootable"].as<u32>(0);
+		entry.info.attr         = node["attr"].as<u32>(0);
+		index.emplace(pair.first.Scalar(), std::move(entry));
+	}
+
+	return index;
+}
+
+static void save_game_list_index(const game_list_index& index)
+{
+	YAML::Emitter out;
+	out << YAML::BeginMap;
+
+	for (const auto& [path, entry] : index)
+	{
+		out << YAML::Key << path << YAML::Value << YAML::BeginMap;
+		out << YAML::Key << "mtime" << YAML::Value << entry.mtime;
+		out << YAML::Key << "size" << YAML::Value << entry.size;
+		out << YAML::Key << "serial" << YAML::Value << entry.info.serial;
+		out << YAML::Key << "name" << YAML::Value << entry.info.name;
+		out << YAML::Key << "app_ver" << YAML::Value << entry.info.app_ver;
+		out << YAML::Key << "version" << YAML::Value << entry.info.version;
+		out << YAML::Key << "category" << YAML::Value << entry.info.category;
+		out << YAML::Key << "fw" << YAML::Value << entry.info.fw;
+		out << YAML::Key << "parental_lvl" << YAML::Value << entry.info.parental_lvl;
+		out << YAML::Key << "resolution" << YAML::Value << entry.info.resolution;
+		out << YAML::Key << "sound_format" << YAML::Value << entry.info.sound_format;
+		out << YAML::Key << "bootable" << YAML::Value << entry.info.bootable;
+		out << YAML::Key << "attr" << YAML::Value << entry.info.attr;
+		out << YAML::EndMap;
+	}
+
+	out << YAML::EndMap;
+
+	if (!fs::file(get_game_list_index_path(), fs::rewrite).write(out.c_str(), out.size()))
+	{
+		game_list_log.error("Failed to save the game list index: %s", fs::g_tls_error);
+	}
+}
 LOG_CHANNEL(sys_log, "SYS");
 
 inline std::string sstr(const QString& _in) { return _in.toStdString(); }
@@ -96,6 +192,13 @@ game_list_frame::game_list_frame(std::shared_ptr<gui_settings> gui_settings, std
 
 	m_game_compat = std::make_unique<game_compatibility>(m_gui_settings);
 
+	m_icon_loader = new QFutureWatcher<game_icon>(this);
+	connect(m_icon_loader, &QFutureWatcher<game_icon>::resultReadyAt, this, &game_list_frame::OnIconLoaded);
+	connect(m_icon_loader, &QFutureWatcher<game_icon>::finished, this, [this]()
+	{
+		RepaintIcons();
+	});
+
 	m_central_widget = new QStackedWidget(this);
 	m_central_widget->addWidget(m_game_list);
 	m_central_widget->addWidget(m_game_grid);
@@ -230,6 +333,10 @@ void game_list_frame::LoadSettings()
 
 game_list_frame::~game_list_frame()
 {
+	m_icon_loader->disconnect(this);
+	m_icon_loader->cancel();
+	m_icon_loader->waitForFinished();
+
 	SaveSettings();
 }
 
@@ -538,37 +645,72 @@ void game_list_frame::Refresh(const bool from_drive, const bool scroll_after)
 
 		lf_queue<game_info> games;
 
+		// PARAM.SFO files are only parsed if they changed since the last refresh
+		const game_list_index index = load_game_list_index();
+		game_list_index new_index;
+		atomic_t<u32> index_misses = 0;
+
 		QtConcurrent::blockingMap(path_list, [&](const std::string& dir)
 		{
 			const Localized thread_localized;
 
 			{
 				const std::string sfo_dir = Emulator::GetSfoDirFromGamePath(dir, Emu.GetUsr());
-				const fs::file sfo_file(sfo_dir + "/PARAM.SFO");
-				if (!sfo_file)
+				const std::string sfo_path = sfo_dir + "/PARAM.SFO";
+
+				fs::stat_t sfo_stat{};
+				if (!fs::stat(sfo_path, sfo_stat) || sfo_stat.is_directory)
 				{
 					return;
 				}
 
-				const auto psf = psf::load_object(sfo_file);
-
 				GameInfo game;
-				game.path         = dir;
-				game.icon_path    = sfo_dir + "/ICON0.PNG";
-				game.serial       = psf::get_string(psf, "TITLE_ID", "");
-				game.name         = psf::get_string(psf, "TITLE", cat_unknown_localized);
-				game.app_ver      = psf::get_string(psf, "APP_VER", cat_unknown_localized);
-				game.version      = psf::get_string(psf, "VERSION", cat_unknown_localized);
-				game.category     = psf::get_string(psf, "CATEGORY", cat_unknown);
-				game.fw           = psf::get_string(psf, "PS3_SYSTEM_VER", cat_unknown_localized);
-				game.parental_lvl = psf::get_integer(psf, "PARENTAL_LEVEL", 0);
-				game.resolution   = psf::get_integer(psf, "RESOLUTION", 0);
-				game.sound_format = psf::get_integer(psf, "SOUND_FORMAT", 0);
-				game.bootable     = psf::get_integer(psf, "BOOTABLE", 0);
-				game.attr         = psf::get_integer(psf, "ATTRIBUTE", 0);
+
+				if (const auto found = index.find(sfo_path); found != index.end() && found->second.mtime == sfo_stat.mtime && found->second.size == sfo_stat.size)
+				{
+					game = found->second.info;
+				}
+				else
+				{
+					const fs::file sfo_file(sfo_path);
+					if (!sfo_file)
+					{
+						return;
+					}
+
+					const auto psf = psf::load_object(sfo_file);
+
+					game.serial       = psf::get_string(psf, "TITLE_ID", "");
+					game.name         = psf::get_string(psf, "TITLE", "");
+					game.app_ver      = psf::get_string(psf, "APP_VER", "");
+					game.version      = psf::get_string(psf, "VERSION", "");
+					game.category     = psf::get_string(psf, "CATEGORY", "");
+					game.fw           = psf::get_string(psf, "PS3_SYSTEM_VER", "");
+					game.parental_lvl = psf::get_integer(psf, "PARENTAL_LEVEL", 0);
+					game.resolution   = psf::get_integer(psf, "RESOLUTION", 0);
+					game.sound_format = psf::get_integer(psf, "SOUND_FORMAT", 0);
+					game.bootable     = psf::get_integer(psf, "BOOTABLE", 0);
+					game.attr         = psf::get_integer(psf, "ATTRIBUTE", 0);
+
+					index_misses++;
+				}
+
+				game_list_index_entry index_entry{sfo_stat.mtime, sfo_stat.size, game};
+
+				// Missing values (stored empty in the index)
+				if (game.name.empty()) game.name = cat_unknown_localized;
+				if (game.app_ver.empty()) game.app_ver = cat_unknown_localized;
+				if (game.version.empty()) game.version = cat_unknown_localized;
+				if (game.category.empty()) game.category = cat_unknown;
+				if (game.fw.empty()) game.fw = cat_unknown_localized;
+
+				game.path      = dir;
+				game.icon_path = sfo_dir + "/ICON0.PNG";
 
 				mutex_cat.lock();
 
+				new_index.emplace(sfo_path, std::move(index_entry));
+
 				const QString serial = qstr(game.serial);
 				const QString note = m_gui_settings->GetValue(gui::notes, serial, "").toString();
 				const QString title = m_gui_settings->GetValue(gui::titles, serial, "").toString().simplified();
@@ -631,12 +773,15 @@ void game_list_frame::Refresh(const bool from_drive, const bool scroll_after)
 
 				mutex_cat.unlock();
 
-				// Load ICON0.PNG
+				// Use ICON0.PNG decoded by a previous refresh, others are loaded in the background (see LoadIcons)
 				QPixmap icon;
 
-				if (game.icon_path.empty() || !icon.load(qstr(game.icon_path)))
+				if (fs::stat_t icon_stat{}; fs::stat(game.icon_path, icon_stat))
 				{
-					game_list_log.warning("Could not load image from path %s", sstr(QDir(qstr(game.icon_path)).absolutePath()));
+					if (const auto found = m_icon_cache.constFind(qstr(game.icon_path)); found != m_icon_cache.cend() && found->mtime == icon_stat.mtime)
+					{
+						icon = found->icon;
+					}
 				}
 
 				const auto compat = m_game_compat->GetCompatibility(game.serial);
@@ -656,6 +801,12 @@ void game_list_frame::Refresh(const bool from_drive, const bool scroll_after)
 			m_game_data.push_back(std::move(g));
 		}
 
+		if (index_misses || new_index.size() != index.size())
+		{
+			game_list_log.notice("Updating the game list index (%u of %u entries parsed)", index_misses.load(), new_index.size());
+			save_game_list_index(new_index);
+		}
+
 		// Try to update the app version for disc games if there is a patch
 		for (const auto& entry : m_game_data)
 		{
@@ -712,6 +863,8 @@ void game_list_frame::Refresh(const bool from_drive, const bool scroll_after)
 		// clean up hidden games list
 		m_hidden_list.intersect(serials);
 		m_gui_settings->SetValue(gui::gl_hidden_list, QStringList(m_hidden_list.values()));
+
+		LoadIcons();
 	}
 
 	// Fill Game List / Game Grid
@@ -1652,7 +1805,7 @@ void game_list_frame::BatchRemoveShaderCaches()
 QPixmap game_list_frame::PaintedPixmap(const QPixmap& icon, bool paint_config_icon, bool paint_pad_config_icon, const QColor& compatibility_color)
 {
 	const qreal device_pixel_ratio = devicePixelRatioF();
-	const QSize original_size = icon.size();
+	const QSize original_size = icon.isNull() ? gui::gl_icon_size_max : icon.size();
 
 	QPixmap canvas = QPixmap(original_size * device_pixel_ratio);
 	canvas.setDevicePixelRatio(device_pixel_ratio);
@@ -1729,6 +1882,64 @@ void game_list_frame::ShowCustomConfigIcon(game_info game)
 	RepaintIcons();
 }
 
+void game_list_frame::LoadIcons()
+{
+	if (m_icon_loader->isRunning())
+	{
+		m_icon_loader->cancel();
+		m_icon_loader->waitForFinished();
+	}
+
+	QList<game_info> games;
+
+	for (const auto& game : m_game_data)
+	{
+		if (game->icon.isNull())
+		{
+			games.push_back(game);
+		}
+	}
+
+	if (games.isEmpty())
+	{
+		return;
+	}
+
+	std::function<game_icon(const game_info&)> load = [](const game_info& game) -> game_icon
+	{
+		game_icon result{game};
+
+		if (fs::stat_t icon_stat{}; fs::stat(game->info.icon_path, icon_stat))
+		{
+			result.mtime = icon_stat.mtime;
+		}
+
+		if (game->info.icon_path.empty() || !result.icon.load(qstr(game->info.icon_path)))
+		{
+			game_list_log.warning("Could not load image from path %s", sstr(QDir(qstr(game->info.icon_path)).absolutePath()));
+		}
+
+		return result;
+	};
+
+	m_icon_loader->setFuture(QtConcurrent::mapped(games, load));
+}
+
+void game_list_frame::OnIconLoaded(int index)
+{
+	const game_icon result = m_icon_loader->resultAt(index);
+
+	if (result.icon.isNull())
+	{
+		return;
+	}
+
+	m_icon_cache.insert(qstr(result.game->info.icon_path), cached_icon{result.mtime, result.icon});
+
+	// The pixmap is painted for all icons at once when loading finishes
+	result.game->icon = result.icon;
+}
+
 void game_list_frame::ResizeIcons(const int& slider_pos)
 {
 	m_icon_size_index = slider_pos;
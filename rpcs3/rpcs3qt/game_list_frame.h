@@ -7,6 +7,7 @@
 #include "gui_save.h"
 
 #include <QMainWindow>
+#include <QFutureWatcher>
 #include <QToolBar>
 #include <QStackedWidget>
 #include <QSet>
@@ -85,6 +86,7 @@ private Q_SLOTS:
 	void ShowContextMenu(const QPoint &pos);
 	void doubleClickedSlot(QTableWidgetItem *item);
 	void itemSelectionChangedSlot();
+	void OnIconLoaded(int index);
 Q_SIGNALS:
 	void GameListFrameClosed();
 	void NotifyGameSelection(const game_info& game);
@@ -100,6 +102,7 @@ private:
 	QPixmap PaintedPixmap(const QPixmap& icon, bool paint_config_icon = false, bool paint_pad_config_icon = false, const QColor& color = QColor());
 	QColor getGridCompatibilityColor(const QString& string);
 	void ShowCustomConfigIcon(game_info game);
+	void LoadIcons();
 	void PopulateGameList();
 	void PopulateGameGrid(int maxCols, const QSize& image_size, const QColor& image_color);
 	bool IsEntryVisible(const game_info& game);
@@ -162,6 +165,22 @@ private:
 	// Icons
 	QColor m_icon_color;
 	QSize m_icon_size;
+
+	struct game_icon
+	{
+		game_info game;
+		QPixmap icon;
+		s64 mtime = 0;
+	};
+
+	struct cached_icon
+	{
+		s64 mtime = 0;
+		QPixmap icon;
+	};
+
+	QFutureWatcher<game_icon>* m_icon_loader;
+	QHash<QString, cached_icon> m_icon_cache; // Decoded icons by path, reused while the file is unchanged
 	qreal m_margin_factor;
 	qreal m_text_factor;
 	bool m_draw_compat_status_to_grid = false;
@@ -0,0 +1,565 @@
+﻿#include "shader_decompiler_bench.h"
+
+#include "Utilities/File.h"
+#include "Utilities/Thread.h"
+#include "Utilities/sysinfo.h"
+#include "Emu/RSX/Common/ProgramStateCache.h"
+#include "Emu/RSX/rsx_cache.h"
+#include "Emu/RSX/GL/GLFragmentProgram.h"
+#include "Emu/RSX/GL/GLVertexProgram.h"
+
+#if defined(_WIN32) || defined(HAVE_VULKAN)
+#include "Emu/RSX/VK/VKFragmentProgram.h"
+#include "Emu/RSX/VK/VKVertexProgram.h"
+#include "Emu/RSX/VK/VKCommonDecompiler.h"
+#include "Emu/RSX/VK/VKFragmentSPIRV.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+	struct bench_program
+	{
+		std::string path;
+		bool is_fragment;
+
+		// Captured state of the pipeline the program was used with, if any
+		std::string pipeline;
+		rsx::pipeline_program_data state{};
+	};
+
+	struct bench_result
+	{
+		std::string backend;
+		u64 time_us = 0;
+		u64 output_size = 0;
+		std::string error;
+		std::string skipped; // Backend does not handle this program (not a failure)
+	};
+
+	struct bench_report
+	{
+		u64 ucode_size = 0;
+		std::vector<bench_result> results;
+		std::string error;
+	};
+
+	std::string json_escape(std::string_view str)
+	{
+		std::string result;
+		result.reserve(str.size());
+
+		for (const char c : str)
+		{
+			switch (c)
+			{
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n"; break;
+			case '\r': result += "\\r"; break;
+			case '\t': result += "\\t"; break;
+			default:
+			{
+				if (static_cast<u8>(c) < 0x20)
+				{
+					result += fmt::format("\\u%04x", static_cast<u8>(c));
+				}
+				else
+				{
+					result += c;
+				}
+
+				break;
+			}
+			}
+		}
+
+		return result;
+	}
+
+	// Adds both programs of a cached pipeline object (<root>/pipelines/<class>/<version>/<name>.bin)
+	void add_pipeline(const std::string& path, std::vector<bench_program>& out)
+	{
+		bench_program vp{}, fp{};
+
+		if (fs::file f{path}; !f || f.size() < sizeof(rsx::pipeline_program_data) || !f.read(vp.state))
+		{
+			std::cerr << "Failed to read pipeline object: " << path << '\n';
+			return;
+		}
+
+		std::string root = path;
+
+		for (int i = 0; i < 4; i++)
+		{
+			root = fs::get_parent_dir(root);
+		}
+
+		vp.path = fmt::format("%s/raw/%llX.vp", root, vp.state.vertex_program_hash);
+		vp.is_fragment = false;
+		vp.pipeline = path;
+
+		fp.path = fmt::format("%s/raw/%llX.fp", root, vp.state.fragment_program_hash);
+		fp.is_fragment = true;
+		fp.pipeline = path;
+		fp.state = vp.state;
+
+		out.push_back(std::move(vp));
+		out.push_back(std::move(fp));
+	}
+
+	// Collects cached pipeline objects from shader cache directories (searched recursively)
+	// Raw *.vp and *.fp files can also be given directly, they are decompiled without any captured state
+	void find_programs(const std::string& path, std::vector<bench_program>& out, bool is_root = true)
+	{
+		if (fs::is_file(path))
+		{
+			if (path.ends_with(".bin"))
+			{
+				add_pipeline(path, out);
+			}
+			else if (is_root && (path.ends_with(".fp") || path.ends_with(".vp")))
+			{
+				bench_program prog{};
+				prog.path = path;
+				prog.is_fragment = path.ends_with(".fp");
+				out.push_back(std::move(prog));
+			}
+
+			return;
+		}
+
+		for (const auto& entry : fs::dir(path))
+		{
+			if (entry.name == "." || entry.name == "..")
+			{
+				continue;
+			}
+
+			const std::string entry_path = path + "/" + entry.name;
+
+			if (entry.is_directory)
+			{
+				find_programs(entry_path, out, false);
+			}
+			else if (entry.name.ends_with(".bin"))
+			{
+				add_pipeline(entry_path, out);
+			}
+		}
+	}
+
+	template <typename F>
+	bench_result run_backend(std::string backend, F&& func)
+	{
+		bench_result result;
+		result.backend = std::move(backend);
+
+		const auto start = std::chrono::steady_clock::now();
+
+		try
+		{
+			result.output_size = func();
+		}
+		catch (const std::exception& e)
+		{
+			result.error = e.what();
+		}
+
+		result.time_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		return result;
+	}
+
+	// Returns false if the ucode does not terminate within the stored data
+	bool validate_fragment_ucode(const std::vector<u8>& data)
+	{
+		for (std::size_t offset = 0; offset + 16 <= data.size();)
+		{
+			const v128 inst = v128::loadu(data.data() + offset);
+			const bool end = (inst._u32[0] >> 8) & 0x1;
+
+			const bool has_constant = program_hash_util::fragment_program_utils::is_constant(inst._u32[1]) ||
+				program_hash_util::fragment_program_utils::is_constant(inst._u32[2]) ||
+				program_hash_util::fragment_program_utils::is_constant(inst._u32[3]);
+
+			offset += has_constant ? 32 : 16;
+
+			if (end)
+			{
+				return offset <= data.size();
+			}
+		}
+
+		return false;
+	}
+
+#if defined(_WIN32) || defined(HAVE_VULKAN)
+	// Checks a directly emitted module against the one glslang produced from the GLSL path (if any)
+	std::string compare_direct_spirv(const vk::spirv_fragment_program& direct, const std::vector<size_t>& constant_offsets, const std::vector<u32>& glsl_spv)
+	{
+		std::string error;
+
+		if (!vk::validate_spirv(direct.code, error))
+		{
+			return "Validation failed: " + error;
+		}
+
+		if (direct.constant_offsets != constant_offsets)
+		{
+			return fmt::format("Constant layout mismatch (%u constants, expected %u)", direct.constant_offsets.size(), constant_offsets.size());
+		}
+
+		if (glsl_spv.empty())
+		{
+			return {};
+		}
+
+		const auto direct_interface = vk::get_spirv_interface(direct.code);
+		const auto glsl_interface = vk::get_spirv_interface(glsl_spv);
+
+		for (const std::string& entry : glsl_interface)
+		{
+			// Uniform blocks the direct path doesn't read (TextureParametersBuffer) may be missing
+			if (!entry.starts_with("uniform ") && std::find(direct_interface.begin(), direct_interface.end(), entry) == direct_interface.end())
+			{
+				return "Missing interface variable: " + entry;
+			}
+		}
+
+		for (const std::string& entry : direct_interface)
+		{
+			if (std::find(glsl_interface.begin(), glsl_interface.end(), entry) == glsl_interface.end())
+			{
+				return "Unexpected interface variable: " + entry;
+			}
+		}
+
+		return {};
+	}
+#endif
+
+	void bench_fragment_program(const bench_program& prog, bool compile_spirv, bench_report& report)
+	{
+		std::vector<u8> data;
+
+		if (fs::file f{prog.path}; !f || !f.read<u8>(data, f.size()))
+		{
+			report.error = "Failed to read file";
+			return;
+		}
+
+		report.ucode_size = data.size();
+
+		if (!validate_fragment_ucode(data))
+		{
+			report.error = "Missing end instruction";
+			return;
+		}
+
+		RSXFragmentProgram fp{};
+		fp.addr = data.data();
+		fp.ucode_length = ::size32(data);
+
+		if (!prog.pipeline.empty())
+		{
+			prog.state.unpack_fragment_program(fp);
+		}
+
+		report.results.emplace_back(run_backend("gl", [&]() -> u64
+		{
+			u32 size = 0;
+			std::string source;
+			ParamArray parr;
+			GLFragmentDecompilerThread decompiler(source, parr, fp, size);
+			decompiler.Task();
+			return source.size();
+		}));
+
+#if defined(_WIN32) || defined(HAVE_VULKAN)
+		std::string vk_source;
+		std::vector<size_t> vk_constants;
+
+		report.results.emplace_back(run_backend("vk", [&]() -> u64
+		{
+			u32 size = 0;
+			VKFragmentProgram dst;
+			VKFragmentDecompilerThread decompiler(vk_source, dst.parr, fp, size, dst);
+			decompiler.Task();
+
+			// Same as VKFragmentProgram::Decompile
+			for (const ParamType& PT : decompiler.m_parr.params[PF_PARAM_UNIFORM])
+			{
+				if (PT.type == "sampler1D" ||
+					PT.type == "sampler2D" ||
+					PT.type == "sampler3D" ||
+					PT.type == "samplerCube")
+					continue;
+
+				for (const ParamItem& PI : PT.items)
+				{
+					vk_constants.push_back(atoi(PI.name.c_str() + 2));
+				}
+			}
+
+			return vk_source.size();
+		}));
+
+		if (!report.results.back().error.empty())
+		{
+			return;
+		}
+
+		std::vector<u32> vk_spirv;
+
+		if (compile_spirv)
+		{
+			report.results.emplace_back(run_backend("spirv", [&]() -> u64
+			{
+				if (!vk::compile_glsl_to_spv(vk_source, ::glsl::program_domain::glsl_fragment_program, vk_spirv))
+				{
+					fmt::throw_exception("glslang failed to compile the shader" HERE);
+				}
+
+				return vk_spirv.size() * sizeof(u32);
+			}));
+		}
+
+		const auto options = VKFragmentProgram::get_direct_spirv_options(vk::get_pipeline_binding_table(32u));
+		vk::spirv_fragment_program direct;
+
+		report.results.emplace_back(run_backend("spirv-direct", [&]() -> u64
+		{
+			vk::emit_fragment_program_spirv(fp, options, direct);
+			return direct.code.size() * sizeof(u32);
+		}));
+
+		if (bench_result& result = report.results.back(); !direct.unsupported.empty())
+		{
+			result.skipped = direct.unsupported;
+		}
+		else if (result.error.empty())
+		{
+			result.error = compare_direct_spirv(direct, vk_constants, vk_spirv);
+		}
+#endif
+	}
+
+	void bench_vertex_program(const bench_program& prog, bool compile_spirv, bench_report& report)
+	{
+		std::vector<u32> data;
+
+		if (fs::file f{prog.path}; !f || !f.read<u32>(data, f.size() / sizeof(u32)))
+		{
+			report.error = "Failed to read file";
+			return;
+		}
+
+		report.ucode_size = data.size() * sizeof(u32);
+
+		if (data.empty() || data.size() > 512 * 4)
+		{
+			report.error = "Invalid ucode size";
+			return;
+		}
+
+		RSXVertexProgram vp{};
+		vp.skip_vertex_input_check = true;
+
+		if (!prog.pipeline.empty())
+		{
+			// Same as loading the pipeline from the shader cache
+			vp.data = std::move(data);
+			prog.state.unpack_vertex_program(vp);
+		}
+		else
+		{
+			// Raw programs are stored relocated to their first instruction, so the entry point is 0
+			data.resize(512 * 4);
+
+			try
+			{
+				program_hash_util::vertex_program_utils::analyse_vertex_program(data.data(), 0, vp);
+			}
+			catch (const std::exception& e)
+			{
+				report.error = e.what();
+				return;
+			}
+		}
+
+		report.results.emplace_back(run_backend("gl", [&]() -> u64
+		{
+			std::string source;
+			ParamArray parr;
+			GLVertexDecompilerThread decompiler(vp, source, parr);
+			decompiler.Task();
+			return source.size();
+		}));
+
+#if defined(_WIN32) || defined(HAVE_VULKAN)
+		std::string vk_source;
+
+		report.results.emplace_back(run_backend("vk", [&]() -> u64
+		{
+			VKVertexProgram dst;
+			VKVertexDecompilerThread decompiler(vp, vk_source, dst.parr, dst);
+			decompiler.Task();
+			return vk_source.size();
+		}));
+
+		if (compile_spirv && report.results.back().error.empty())
+		{
+			report.results.emplace_back(run_backend("spirv", [&]() -> u64
+			{
+				std::vector<u32> spv;
+
+				if (!vk::compile_glsl_to_spv(vk_source, ::glsl::program_domain::glsl_vertex_program, spv))
+				{
+					fmt::throw_exception("glslang failed to compile the shader" HERE);
+				}
+
+				return spv.size() * sizeof(u32);
+			}));
+		}
+#endif
+	}
+}
+
+int run_shader_decompiler_bench(const std::vector<std::string>& paths, bool compile_spirv)
+{
+	std::vector<bench_program> programs;
+
+	for (const std::string& path : paths)
+	{
+		if (!fs::exists(path))
+		{
+			std::cerr << "Path not found: " << path << '\n';
+			return 1;
+		}
+
+		find_programs(path, programs);
+	}
+
+	// Decompilers normally run with a live context, use baseline device properties instead
+	gl::init_offline_driver_caps();
+
+#if defined(_WIN32) || defined(HAVE_VULKAN)
+	if (compile_spirv)
+	{
+		vk::initialize_compiler_context();
+	}
+#else
+	compile_spirv = false;
+#endif
+
+	std::vector<bench_report> reports(programs.size());
+	atomic_t<u32> next = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	{
+		named_thread_group workers("Decompiler Bench ", utils::get_thread_count(), [&]()
+		{
+			for (u32 i = next++; i < programs.size(); i = next++)
+			{
+				if (programs[i].is_fragment)
+				{
+					bench_fragment_program(programs[i], compile_spirv, reports[i]);
+				}
+				else
+				{
+					bench_vertex_program(programs[i], compile_spirv, reports[i]);
+				}
+			}
+		});
+	}
+	const u64 total_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+#if defined(_WIN32) || defined(HAVE_VULKAN)
+	if (compile_spirv)
+	{
+		vk::finalize_compiler_context();
+	}
+#endif
+
+	u32 failures = 0;
+
+	// Programs handled by the direct SPIR-V emitter, and the time the GLSL path (decompiler and glslang) spent on them
+	u32 direct_count = 0;
+	u64 direct_us = 0;
+	u64 glsl_us = 0;
+
+	std::string out = "{\n\t\"programs\": [";
+
+	for (std::size_t i = 0; i < programs.size(); i++)
+	{
+		const bench_report& report = reports[i];
+
+		out += fmt::format("%s\n\t\t{\"file\": \"%s\", \"type\": \"%s\", \"ucode_size\": %u", i ? "," : "",
+			json_escape(programs[i].path), programs[i].is_fragment ? "fragment" : "vertex", report.ucode_size);
+
+		if (!programs[i].pipeline.empty())
+		{
+			out += fmt::format(", \"pipeline\": \"%s\"", json_escape(programs[i].pipeline));
+		}
+
+		if (!report.error.empty())
+		{
+			failures++;
+			out += fmt::format(", \"error\": \"%s\"", json_escape(report.error));
+		}
+
+		out += ", \"results\": [";
+
+		for (std::size_t j = 0; j < report.results.size(); j++)
+		{
+			const bench_result& result = report.results[j];
+
+			out += fmt::format("%s{\"backend\": \"%s\", \"time_us\": %u, \"output_size\": %u", j ? ", " : "",
+				result.backend, result.time_us, result.output_size);
+
+			if (!result.error.empty())
+			{
+				failures++;
+				out += fmt::format(", \"error\": \"%s\"", json_escape(result.error));
+			}
+			else if (!result.skipped.empty())
+			{
+				out += fmt::format(", \"skipped\": \"%s\"", json_escape(result.skipped));
+			}
+			else if (result.backend == "spirv-direct")
+			{
+				direct_count++;
+				direct_us += result.time_us;
+
+				for (const bench_result& other : report.results)
+				{
+					if (other.backend == "vk" || other.backend == "spirv")
+					{
+						glsl_us += other.time_us;
+					}
+				}
+			}
+
+			out += "}";
+		}
+
+		out += "]}";
+	}
+
+	out += fmt::format("\n\t],\n\t\"count\": %u,\n\t\"failures\": %u,\n\t\"threads\": %u,\n\t\"total_time_us\": %u",
+		programs.size(), failures, utils::get_thread_count(), total_us);
+
+	if (direct_count)
+	{
+		out += fmt::format(",\n\t\"direct_spirv\": {\"programs\": %u, \"time_us\": %u, \"glsl_time_us\": %u, \"includes_glslang\": %s}",
+			direct_count, direct_us, glsl_us, compile_spirv ? "true" : "false");
+	}
+
+	out += "\n}\n";
+
+	std::cout << out;
+	return failures ? 2 : 0;
+}
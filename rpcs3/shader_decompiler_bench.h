@@ -0,0 +1,7 @@
+﻿#pragma once
+
+#include <string>
+#include <vector>
+
+// Decompiles the programs of every cached pipeline found in the given shader cache directories and writes a JSON report to stdout
+int run_shader_decompiler_bench(const std::vector<std::string>& paths, bool compile_spirv);